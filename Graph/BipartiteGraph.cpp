@@ -1,47 +1,522 @@
 // 単純有向2部グラフ
 
 // 最大マッチング
+//   Kuhn:         増加路を 1 本ずつ探す O(|V| |E|)
+//   HopcroftKarp: BFS で層を作り, 頂点素な最短増加路をまとめて流す O(|E| sqrt(|V|))
+//                 貪欲法で初期マッチングを作ってから始める
+//                 DFS は明示的なスタックで行うので, 頂点数が大きくても再帰が深くならない
+//   matching は最大マッチングの大きさ, pairs はマッチした組 (x, y) を x の昇順に返す
 
-#include<functional>
+// 逐次的な最大マッチング
+//   warm_matching を一度呼ぶと HopcroftKarp で求めたマッチングを保持し, 以後は辺・頂点の追加と削除のたびに局所的に修復する
+//     辺 (x, y) の追加:   増えるとすれば (x, y) を通る増加路が 1 本だけなので, x, y 側から 1 回ずつ交互路を探す
+//     頂点の削除:         相手だった頂点から 1 回だけ交互路を探す (最大マッチングは高々 1 しか減らない)
+//   交互路の探索はタイムスタンプで訪問済みを管理するので, 1 回の探索は訪れた頂点と辺の数に比例する
+//   削除した頂点は孤立点として残り, 番号は詰めない (左側の頂点を削除すると assignment は COST_INF を返す)
+
+// 重み付き割当 (左側の頂点をすべてマッチさせるときの辺の費用の和の最小化)
+//   辺の費用は insert の第 3 引数で与える (整数)
+//   左側の頂点をすべてマッチさせられない場合は cost = COST_INF を返す
+//   Hungarian: 費用行列を作って最短増加路で 1 行ずつ割り当てる (Jonker-Volgenant 型) O(|X|^2 |Y|)
+//              密な費用行列向け, メモリ O(|X| |Y|)
+//              u[x] + v[y] <= c(x, y) (すべての辺), マッチした辺では等号, v[y] <= 0 (マッチしない y では 0)
+//   Auction:   ε-スケーリングのオークション法, 疎なグラフ向け
+//              費用を (|Y| + 1) 倍して最後に ε = 1 で終えるので最適解が得られる
+//              |X| < |Y| のときは右側すべてと費用 0 で結ばれたダミーの左頂点を |Y| - |X| 個加える (ダミーの入札は O(|Y|))
+//              入札はマッチしていない左頂点をスレッドに分けて並列に計算し (Jacobi 型), 落札は 1 スレッドで番号順に決める
+//                ⇒ 結果はスレッド数に依らない
+//              u[x] + v[y] <= c(x, y) (すべての辺), マッチした辺では c(x, y) - 1 / (|Y| + 1) < u[x] + v[y]
+//              ※ threads > 1 のときは -pthread を付けてコンパイルする
+
+// 密な2部グラフの最大マッチング (DenseBipartiteGraph)
+//   隣接行列の各行を 64 bit 単位の bitset で持つ (メモリ |X| |Y| / 8 bytes)
+//   交互路の探索では「行 & 未訪問の右側の頂点」を 1 語ずつ調べ, 最下位 bit (countr_zero) を次の頂点とする
+//     ⇒ 辺 1 本ずつではなく 64 本ずつ調べる
+//   未訪問の集合はパスの間で共有し, 1 本も増加しなかったパスで終了する O(|X| |Y| / 64) / パス
+//     増加のなかったパスではマッチングが変わらないので, 訪問済みの頂点から増加路がないことは正しい
+
+#include<algorithm>
+#include<barrier>
+#include<bit>
+#include<cassert>
+#include<cstdint>
+#include<limits>
+#include<thread>
+#include<utility>
 #include<vector>
 
 class BipartiteGraph {
  public:
-  BipartiteGraph(int X, int Y) : X(X), Y(Y), G(X + Y) {}
-  void insert(int x, int y) {G[x].emplace_back(X + y);}
-  int matching() const {
-    // Ford-Fullkerson O(最大流量 * 辺数)
-    std::vector<int> match_to(G.size(), -1);
-    std::vector<bool> used(G.size(), false);
-    std::function<bool(int)> dfs = [&](int from) {
-      if(from == -1) return true;
-      if(used[from]) return false;
-      used[from] = true;
-      for(const auto& to: G[from]) if(dfs(match_to[to])) {
-        match_to[from] = to;
-        match_to[to] = from;
+  // matching, pairs のアルゴリズムと, assignment のアルゴリズム
+  enum class Matching {Kuhn, HopcroftKarp};
+  enum class Assigner {Hungarian, Auction};
+  using Cost = long long;
+  static constexpr Cost COST_INF = std::numeric_limits<Cost>::max();
+  struct Assignment {
+    Cost cost;                      // 費用の和
+    std::vector<int> match;         // 左側の各頂点のマッチ相手
+    std::vector<long double> u, v;  // 左側, 右側の各頂点の双対変数 (価格)
+  };
+  BipartiteGraph(int X, int Y) : X(X), Y(Y), G(X), C(X), R(Y) {}
+  void insert(int x, int y, Cost cost = 0) {
+    G[x].emplace_back(y);
+    C[x].emplace_back(cost);
+    R[y].emplace_back(x);
+    if(!warm_.active) return;
+    auto& [active, size, left, right, stamp_left, stamp_right, clock] = warm_;
+    if(left[x] != -1 && right[y] != -1) {
+      // y の相手を別の右側の頂点に付け替えて y を空ける
+      if(!augment(right[y], G, left, right, stamp_left, clock)) return;
+      right[y] = -1;
+    }
+    if(left[x] == -1 && right[y] == -1) {
+      left[x] = y, right[y] = x, ++size;
+    } else if(left[x] == -1) {
+      size += augment(x, G, left, right, stamp_left, clock);
+    } else {
+      size += augment(y, R, right, left, stamp_right, clock);
+    }
+  }
+  // 頂点を追加して番号を返す
+  int insert_left() {
+    G.emplace_back();
+    C.emplace_back();
+    if(warm_.active) warm_.left.emplace_back(-1), warm_.stamp_left.emplace_back(0);
+    return X++;
+  }
+  int insert_right() {
+    R.emplace_back();
+    if(warm_.active) warm_.right.emplace_back(-1), warm_.stamp_right.emplace_back(0);
+    return Y++;
+  }
+  // 頂点に接続する辺をすべて削除する
+  void erase_left(int x) {
+    for(auto y: G[x]) R[y].erase(std::find(std::begin(R[y]), std::end(R[y]), x));
+    G[x].clear();
+    C[x].clear();
+    if(!warm_.active || warm_.left[x] == -1) return;
+    auto& [active, size, left, right, stamp_left, stamp_right, clock] = warm_;
+    auto y = left[x];
+    left[x] = right[y] = -1;
+    size += augment(y, R, right, left, stamp_right, clock) - 1;
+  }
+  void erase_right(int y) {
+    for(auto x: R[y]) {
+      auto i = std::find(std::begin(G[x]), std::end(G[x]), y) - std::begin(G[x]);
+      G[x].erase(std::begin(G[x]) + i);
+      C[x].erase(std::begin(C[x]) + i);
+    }
+    R[y].clear();
+    if(!warm_.active || warm_.right[y] == -1) return;
+    auto& [active, size, left, right, stamp_left, stamp_right, clock] = warm_;
+    auto x = right[y];
+    left[x] = right[y] = -1;
+    size += augment(x, G, left, right, stamp_left, clock) - 1;
+  }
+  int matching(Matching algorithm = Matching::HopcroftKarp) const {
+    auto match_to = match(algorithm);
+    return X - std::count(std::begin(match_to), std::end(match_to), -1);
+  }
+  std::vector<std::pair<int, int>> pairs(Matching algorithm = Matching::HopcroftKarp) const {
+    auto match_to = match(algorithm);
+    std::vector<std::pair<int, int>> result;
+    for(int x = 0; x < X; ++x) if(match_to[x] != -1) result.emplace_back(x, match_to[x]);
+    return result;
+  }
+  Assignment assignment(Assigner algorithm = Assigner::Hungarian, int threads = 1) const {
+    if(matching() < X) return {COST_INF, {}, {}, {}};
+    switch(algorithm) {
+      case Assigner::Hungarian: return Hungarian();
+      case Assigner::Auction:   return Auction(threads);
+    }
+    assert(false);
+    return {COST_INF, {}, {}, {}};
+  }
+  // 保持しているマッチングの大きさ (初回のみ HopcroftKarp で求める)
+  int warm_matching() {
+    if(!warm_.active) {
+      warm_.active = true;
+      warm_.left = HopcroftKarp();
+      warm_.right.assign(Y, -1);
+      for(int x = 0; x < X; ++x) if(warm_.left[x] != -1) warm_.right[warm_.left[x]] = x;
+      warm_.size = X - std::count(std::begin(warm_.left), std::end(warm_.left), -1);
+      warm_.stamp_left.assign(X, 0);
+      warm_.stamp_right.assign(Y, 0);
+    }
+    return warm_.size;
+  }
+  // 保持しているマッチングの組 (x, y) を x の昇順に返す
+  std::vector<std::pair<int, int>> warm_pairs() {
+    warm_matching();
+    std::vector<std::pair<int, int>> result;
+    for(int x = 0; x < X; ++x) if(warm_.left[x] != -1) result.emplace_back(x, warm_.left[x]);
+    return result;
+  }
+ private:
+  int X, Y;
+  std::vector<std::vector<int>> G;    // 左側の各頂点に隣接する右側の頂点
+  std::vector<std::vector<Cost>> C;   // C[x][i] は辺 (x, G[x][i]) の費用
+  std::vector<std::vector<int>> R;    // 右側の各頂点に隣接する左側の頂点
+  // 逐次的な最大マッチングの状態
+  struct Warm {
+    bool active = false;
+    int size = 0;
+    std::vector<int> left, right;               // 左側, 右側の各頂点のマッチ相手
+    std::vector<int> stamp_left, stamp_right;   // 最後に訪れた探索の番号
+    int clock = 0;
+  } warm_;
+  // 頂点 s から交互路を探し, 見つかれば増加させて true を返す
+  //   adj は s の側の隣接リスト, mine, other は s の側と反対側のマッチ相手
+  //   s 自身はマッチしていないか, 相手を付け替えてよい頂点 (相手との辺は使わない)
+  //   DFS は明示的なスタックで行い, 訪問済みは stamp[v] == clock で判定する
+  static bool augment(int s, const std::vector<std::vector<int>>& adj, std::vector<int>& mine, std::vector<int>& other, std::vector<int>& stamp, int& clock) {
+    ++clock;
+    std::vector<std::pair<int, std::size_t>> path{{s, 0}};
+    stamp[s] = clock;
+    while(!path.empty()) {
+      auto& [v, i] = path.back();
+      if(i == adj[v].size()) {
+        path.pop_back();
+        continue;
+      }
+      auto to = adj[v][i++];
+      auto w = other[to];
+      if(w == -1) {
+        for(auto [u, j]: path) {
+          mine[u] = adj[u][j - 1];
+          other[mine[u]] = u;
+        }
         return true;
       }
-      return false;
+      if(stamp[w] == clock) continue;
+      stamp[w] = clock;
+      path.emplace_back(w, 0);
+    }
+    return false;
+  }
+  // 左側の各頂点のマッチ相手 (右側の番号 0, ..., Y - 1), マッチしていなければ -1
+  std::vector<int> match(Matching algorithm) const {
+    switch(algorithm) {
+      case Matching::Kuhn:         return Kuhn();
+      case Matching::HopcroftKarp: return HopcroftKarp();
+    }
+    assert(false);
+    return {};
+  }
+  std::vector<int> Kuhn() const {
+    std::vector<int> left(X, -1), right(Y, -1), stamp(X, 0);
+    int clock = 0;
+    for(int x = 0; x < X; ++x) augment(x, G, left, right, stamp, clock);
+    return left;
+  }
+  std::vector<int> HopcroftKarp() const {
+    // 隣接リストを一列に並べる (左側の頂点 x の隣接頂点は adj[start[x]], ..., adj[start[x + 1] - 1])
+    std::vector<int> start(X + 1, 0), adj;
+    for(int x = 0; x < X; ++x) {
+      start[x] = adj.size();
+      adj.insert(std::end(adj), std::begin(G[x]), std::end(G[x]));
+    }
+    start[X] = adj.size();
+    std::vector<int> left(X, -1), right(Y, -1);   // 左側, 右側の各頂点のマッチ相手
+    // 貪欲法による初期マッチング
+    for(int x = 0; x < X; ++x) for(int i = start[x]; i < start[x + 1]; ++i) if(right[adj[i]] == -1) {
+      left[x] = adj[i];
+      right[adj[i]] = x;
+      break;
+    }
+    std::vector<int> level(X), itr(X), q(X), path;
+    while(true) {
+      // マッチしていない左側の頂点からの距離 (交互路の左側の頂点の数) を計算する
+      //   マッチしていない右側の頂点に初めて着いた層より先は調べない
+      int head = 0, tail = 0, limit = X + 1;
+      for(int x = 0; x < X; ++x) {
+        level[x] = left[x] == -1 ? 0 : -1;
+        if(left[x] == -1) q[tail++] = x;
+      }
+      while(head < tail) {
+        auto x = q[head++];
+        if(limit <= level[x]) break;
+        for(int i = start[x]; i < start[x + 1]; ++i) {
+          auto w = right[adj[i]];
+          if(w == -1) limit = level[x] + 1;
+          else if(level[w] == -1) level[w] = level[x] + 1, q[tail++] = w;
+        }
+      }
+      if(X < limit) break;
+      // 層に沿った増加路を頂点素に探して流す
+      //   行き止まりの頂点は距離を -1 にしてこのフェーズでは二度と訪れない
+      std::copy(std::begin(start), std::end(start) - 1, std::begin(itr));
+      for(int root = 0; root < X; ++root) if(left[root] == -1 && level[root] == 0) {
+        path.assign(1, root);
+        while(!path.empty()) {
+          auto x = path.back();
+          auto& i = itr[x];
+          int w = -2;
+          for(; i < start[x + 1]; ++i) {
+            w = right[adj[i]];
+            if(w == -1 || (level[w] == level[x] + 1 && level[w] < limit)) break;
+          }
+          if(i == start[x + 1]) {
+            level[x] = -1;
+            path.pop_back();
+            if(!path.empty()) ++itr[path.back()];
+          } else if(w != -1) {
+            path.emplace_back(w);
+          } else {
+            for(auto v: path) {
+              left[v] = adj[itr[v]];
+              right[left[v]] = v;
+            }
+            break;
+          }
+        }
+      }
+    }
+    return left;
+  }
+  // 左側の頂点をすべてマッチさせられることは確認済み
+  Assignment Hungarian() const {
+    const Cost INF = std::numeric_limits<Cost>::max() / 4;
+    // 1-indexed の費用行列 (辺のない組は INF)
+    std::vector<std::vector<Cost>> a(X + 1, std::vector<Cost>(Y + 1, INF));
+    for(int x = 0; x < X; ++x) for(std::size_t i = 0; i < G[x].size(); ++i) {
+      auto& c = a[x + 1][G[x][i] + 1];
+      c = std::min(c, C[x][i]);
+    }
+    std::vector<Cost> u(X + 1, 0), v(Y + 1, 0), minv(Y + 1);
+    std::vector<int> p(Y + 1, 0), way(Y + 1, 0);   // p[y] は y にマッチした行 (0 ならなし)
+    std::vector<bool> used(Y + 1);
+    for(int i = 1; i <= X; ++i) {
+      // 行 i から列 0 (仮想) への最短増加路を Dijkstra で求める
+      p[0] = i;
+      int j0 = 0;
+      std::fill(std::begin(minv), std::end(minv), INF);
+      std::fill(std::begin(used), std::end(used), false);
+      do {
+        used[j0] = true;
+        int i0 = p[j0], j1 = 0;
+        Cost delta = INF;
+        for(int j = 1; j <= Y; ++j) if(!used[j]) {
+          auto cur = a[i0][j] - u[i0] - v[j];
+          if(cur < minv[j]) minv[j] = cur, way[j] = j0;
+          if(minv[j] < delta) delta = minv[j], j1 = j;
+        }
+        for(int j = 0; j <= Y; ++j) {
+          if(used[j]) u[p[j]] += delta, v[j] -= delta;
+          else minv[j] -= delta;
+        }
+        j0 = j1;
+      } while(p[j0] != 0);
+      // 増加路に沿ってマッチを入れ替える
+      do {
+        int j1 = way[j0];
+        p[j0] = p[j1];
+        j0 = j1;
+      } while(j0);
+    }
+    Assignment result{0, std::vector<int>(X), std::vector<long double>(X), std::vector<long double>(Y)};
+    for(int j = 1; j <= Y; ++j) if(p[j]) result.match[p[j] - 1] = j - 1, result.cost += a[p[j]][j];
+    for(int x = 0; x < X; ++x) result.u[x] = u[x + 1];
+    for(int y = 0; y < Y; ++y) result.v[y] = v[y + 1];
+    return result;
+  }
+  // 左側の頂点をすべてマッチさせられることは確認済み
+  //   利得 -c(x, y) (|Y| + 1) の和を最大化し, 人 x (0 <= x < |Y|, |X| <= x はダミー) が物 y に入札する
+  Assignment Auction(int threads) const {
+    const int n = Y;
+    const Cost scale = n + 1, NONE = std::numeric_limits<Cost>::min();
+    Cost width = 0;   // 利得の絶対値の最大値
+    for(int x = 0; x < X; ++x) for(auto c: C[x]) width = std::max(width, std::abs(c) * scale);
+    std::vector<Cost> price(n, 0);
+    std::vector<int> owner(n, -1), assigned(n, -1);    // 物の持ち主, 人の落札した物
+    std::vector<int> bid_to(n), bidder(n, -1);         // 人の入札先, 物の最高入札者
+    std::vector<Cost> bid(n), best(n);                 // 人の入札額, 物の最高入札額
+    std::vector<int> active, touched;                  // 入札する人, 入札された物
+    // 人 x の最大利得の物と, 最大利得と 2 番目の利得の差 (2 番目がなければ 0)
+    auto evaluate = [&](int x) {
+      Cost first = NONE, second = NONE;
+      int target = -1;
+      auto relax = [&](int y, Cost value) {
+        if(first < value) second = first, first = value, target = y;
+        else if(second < value) second = value;
+      };
+      if(x < X) for(std::size_t i = 0; i < G[x].size(); ++i) relax(G[x][i], -C[x][i] * scale - price[G[x][i]]);
+      else for(int y = 0; y < n; ++y) relax(y, -price[y]);
+      return std::make_pair(target, second == NONE ? Cost(0) : first - second);
+    };
+    Cost eps = std::max(Cost(1), width / 4);
+    auto start_phase = [&]() {
+      std::fill(std::begin(owner), std::end(owner), -1);
+      std::fill(std::begin(assigned), std::end(assigned), -1);
+      active.resize(n);
+      for(int x = 0; x < n; ++x) active[x] = x;
+    };
+    start_phase();
+    bool done = false;
+    // 全スレッドの入札が揃ったら番号順に落札を決める
+    auto resolve = [&]() noexcept {
+      for(auto x: active) {
+        auto y = bid_to[x];
+        if(bidder[y] == -1) touched.emplace_back(y);
+        if(bidder[y] == -1 || best[y] < bid[x]) bidder[y] = x, best[y] = bid[x];
+      }
+      std::vector<int> next;
+      for(auto x: active) if(bidder[bid_to[x]] != x) next.emplace_back(x);
+      for(auto y: touched) {
+        if(owner[y] != -1) assigned[owner[y]] = -1, next.emplace_back(owner[y]);
+        owner[y] = bidder[y];
+        assigned[bidder[y]] = y;
+        price[y] = best[y];
+        bidder[y] = -1;
+      }
+      touched.clear();
+      std::sort(std::begin(next), std::end(next));
+      active.swap(next);
+      if(!active.empty()) return;
+      if(eps == 1) {
+        done = true;
+        return;
+      }
+      eps = std::max(Cost(1), eps / 4);
+      start_phase();
+    };
+    threads = std::max(1, threads);
+    std::barrier sync(threads, resolve);
+    auto run = [&](int k) {
+      while(!done) {
+        for(auto i = k; i < int(active.size()); i += threads) {
+          auto x = active[i];
+          auto [y, gap] = evaluate(x);
+          bid_to[x] = y;
+          bid[x] = price[y] + gap + eps;
+        }
+        sync.arrive_and_wait();
+      }
     };
-    int count = 0;
-    for(int i = 0; i < X; ++i) {
-      used.assign(G.size(), false);
-      if(dfs(i)) ++count;
+    if(threads == 1) {
+      run(0);
+    } else {
+      std::vector<std::thread> pool;
+      for(int k = 0; k < threads; ++k) pool.emplace_back(run, k);
+      for(auto& t: pool) t.join();
+    }
+    Assignment result{0, std::vector<int>(X), std::vector<long double>(X), std::vector<long double>(Y)};
+    for(int x = 0; x < X; ++x) {
+      result.match[x] = assigned[x];
+      Cost profit = NONE, cost = COST_INF;
+      for(std::size_t i = 0; i < G[x].size(); ++i) {
+        auto y = G[x][i];
+        profit = std::max(profit, -C[x][i] * scale - price[y]);
+        if(y == assigned[x]) cost = std::min(cost, C[x][i]);
+      }
+      result.cost += cost;
+      result.u[x] = -(long double)profit / scale;
     }
-    return count;
+    for(int y = 0; y < Y; ++y) result.v[y] = -(long double)price[y] / scale;
+    return result;
+  }
+};
+
+class DenseBipartiteGraph {
+ public:
+  DenseBipartiteGraph(int X, int Y) : X(X), Y(Y), W((Y + 63) / 64), A(std::size_t(X) * W, 0) {}
+  void insert(int x, int y) {A[std::size_t(x) * W + y / 64] |= std::uint64_t(1) << y % 64;}
+  int matching() const {
+    auto match_to = match();
+    return X - std::count(std::begin(match_to), std::end(match_to), -1);
+  }
+  std::vector<std::pair<int, int>> pairs() const {
+    auto match_to = match();
+    std::vector<std::pair<int, int>> result;
+    for(int x = 0; x < X; ++x) if(match_to[x] != -1) result.emplace_back(x, match_to[x]);
+    return result;
   }
  private:
-  int X, Y;
-  std::vector<std::vector<int>> G;
+  int X, Y, W;                  // W は 1 行の語数
+  std::vector<std::uint64_t> A; // 行 x は A[x W], ..., A[x W + W - 1]
+  // 左側の各頂点のマッチ相手 (右側の番号 0, ..., Y - 1), マッチしていなければ -1
+  std::vector<int> match() const {
+    std::vector<int> left(X, -1), right(Y, -1);
+    std::vector<std::uint64_t> unvisited(W);   // 未訪問の右側の頂点 (貪欲法ではマッチしていない右側の頂点)
+    auto reset = [&]() {
+      std::fill(std::begin(unvisited), std::end(unvisited), ~std::uint64_t(0));
+      if(Y % 64) unvisited[W - 1] = (std::uint64_t(1) << Y % 64) - 1;
+    };
+    // 貪欲法による初期マッチング
+    reset();
+    for(int x = 0; x < X; ++x) for(int w = 0; w < W; ++w) if(auto bits = A[std::size_t(x) * W + w] & unvisited[w]) {
+      auto y = w * 64 + std::countr_zero(bits);
+      unvisited[w] &= ~(std::uint64_t(1) << y % 64);
+      left[x] = y, right[y] = x;
+      break;
+    }
+    // 交互路の DFS のスタック (頂点, 次に調べる語, 選んだ右側の頂点)
+    struct Frame {int v, w, y;};
+    std::vector<Frame> path;
+    for(bool augmented = true; augmented; ) {
+      augmented = false;
+      reset();
+      for(int root = 0; root < X; ++root) if(left[root] == -1) {
+        path.assign(1, {root, 0, -1});
+        while(!path.empty()) {
+          auto& [v, w, y] = path.back();
+          const auto* row = A.data() + std::size_t(v) * W;
+          while(w < W && !(row[w] & unvisited[w])) ++w;
+          if(w == W) {
+            path.pop_back();
+            continue;
+          }
+          y = w * 64 + std::countr_zero(row[w] & unvisited[w]);
+          unvisited[w] &= ~(std::uint64_t(1) << y % 64);
+          if(right[y] != -1) {
+            path.push_back({right[y], 0, -1});
+            continue;
+          }
+          for(const auto& f: path) left[f.v] = f.y, right[f.y] = f.v;
+          augmented = true;
+          break;
+        }
+      }
+    }
+    return left;
+  }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include<chrono>
 #include<iostream>
+#include<random>
 using namespace std;
 
 int main() {
+  /*
+  // ベンチマーク (1 コア, 費用は [0, 10^6) の一様乱数)
+  //   FlowNetwork.cpp の minimum_cost_flow (PrimalDual) で同じ問題を解いた時間も併記する
+  //   n = 1000,   完全二部グラフ:  Hungarian 147ms, Auction 189ms, minimum_cost_flow 13492ms
+  //   n = 2000,   次数 8:          Hungarian 856ms, Auction 7ms,   minimum_cost_flow 3470ms
+  //   n = 100000, 次数 8:          Auction 2079ms
+  //   ※ Auction を threads = 4 で動かすと, 1 コアでは同期の分だけ遅くなる
+  auto bench = [](int n, int degree, int threads) {
+    mt19937 rng(1);
+    BipartiteGraph g(n, n);
+    for(int x = 0; x < n; ++x) {
+      if(n <= degree) for(int y = 0; y < n; ++y) g.insert(x, y, rng() % 1000000);
+      else for(int k = 0; k < degree; ++k) g.insert(x, k ? rng() % n : x, rng() % 1000000);
+    }
+    for(auto algorithm: {BipartiteGraph::Assigner::Hungarian, BipartiteGraph::Assigner::Auction}) {
+      if(algorithm == BipartiteGraph::Assigner::Hungarian && 3000 < n) continue;
+      auto start = chrono::steady_clock::now();
+      auto cost = g.assignment(algorithm, threads).cost;
+      auto end = chrono::steady_clock::now();
+      cout << n << " " << degree << ": " << cost << " " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+    }
+  };
+  bench(1000, 1000, 1);
+  bench(2000, 8, 1);
+  bench(100000, 8, 1);
+  */
+
   BipartiteGraph g(3, 4);
   g.insert(0, 0);
   g.insert(0, 2);
@@ -50,4 +525,35 @@ int main() {
   g.insert(2, 2);
   g.insert(2, 3);
   cout << g.matching() << endl;
+  for(auto [x, y]: g.pairs()) cout << x << " " << y << endl;
+
+  // 密な2部グラフ
+  //   |X| = |Y| = 4000, 辺の密度 30% の乱択グラフ: BipartiteGraph (HopcroftKarp) 63ms, DenseBipartiteGraph 1ms
+  DenseBipartiteGraph d(3, 4);
+  d.insert(0, 0);
+  d.insert(0, 2);
+  d.insert(0, 3);
+  d.insert(1, 1);
+  d.insert(2, 2);
+  d.insert(2, 3);
+  cout << d.matching() << endl;
+
+  // 逐次的な最大マッチング
+  cout << g.warm_matching() << endl;
+  g.erase_left(1);
+  cout << g.warm_matching() << endl;
+  g.insert(g.insert_left(), 1);
+  cout << g.warm_matching() << endl;
+
+  // 重み付き割当
+  BipartiteGraph h(3, 3);
+  h.insert(0, 0, 4); h.insert(0, 1, 1); h.insert(0, 2, 3);
+  h.insert(1, 0, 2); h.insert(1, 1, 0); h.insert(1, 2, 5);
+  h.insert(2, 0, 3); h.insert(2, 1, 2); h.insert(2, 2, 2);
+  for(auto algorithm: {BipartiteGraph::Assigner::Hungarian, BipartiteGraph::Assigner::Auction}) {
+    auto [cost, match, u, v] = h.assignment(algorithm);
+    cout << cost << ":";
+    for(auto y: match) cout << " " << y;
+    cout << endl;
+  }
 }
@@ -9,103 +9,392 @@
 //           ← yy →
 
 #include<algorithm>
-#include<cfloat>
+#include<barrier>
+#include<cassert>
+#include<cmath>
+#include<concepts>
 #include<functional>
+#include<limits>
 #include<queue>
+#include<span>
+#include<thread>
+#include<tuple>
+#include<utility>
 #include<vector>
 
 using Vertex = int;
-using Flow   = long double;
-using Cost   = long double;
 
-const Flow FLOW_INF = LDBL_MAX;
-const Cost COST_INF = LDBL_MAX;
+template<std::integral Flow> class GomoryHuTree;
 
+// Flow, Cost は整数型に限る (容量の比較を厳密にし, 容量スケーリングを可能にするため)
+template<std::integral Flow = long long, std::integral Cost = long long>
 class FlowNetwork {
  public:
+  // 最大流と最小費用流でアルゴリズムの種類を分ける (組み合わせを取り違えるとコンパイルエラーになる)
+  enum class MaxFlow {Dinic, HLPP, CapacityScaling};
+  enum class MinCostFlow {PrimalDual, CostScaling, NetworkSimplex};
+  static constexpr Flow FLOW_INF = std::numeric_limits<Flow>::max();
+  static constexpr Cost COST_INF = std::numeric_limits<Cost>::max();
+  // 流量に対する最小費用 (区分線形凸関数)
+  //   flow[i], cost[i]: i 番目の折れ点 (flow[0] = 0, cost[0] = 0)
+  //   operator(): 任意の流量に対する最小費用を二分探索と線形補間で求める O(log k); 流せない場合は COST_INF
+  struct CostCurve {
+    std::vector<Flow> flow;
+    std::vector<Cost> cost;
+    Cost operator()(Flow f) const {
+      if(f < 0 || flow.back() < f) return COST_INF;
+      auto i = std::upper_bound(std::begin(flow), std::end(flow), f) - std::begin(flow) - 1;
+      if(flow[i] == f) return cost[i];
+      return cost[i] + (f - flow[i]) * ((cost[i + 1] - cost[i]) / (flow[i + 1] - flow[i]));
+    }
+  };
   explicit FlowNetwork(int);
-  void insert(Vertex, Vertex, Flow, Cost);
-  Flow maximum_flow(Vertex, Vertex) const;
-  Cost minimum_cost_flow(Vertex, Vertex, Flow) const;
+  int insert(Vertex, Vertex, Flow = 0, Cost = 0);
+  void change(int, Flow);
+  Flow maximum_flow(Vertex, Vertex, MaxFlow = MaxFlow::Dinic) const;
+  Cost minimum_cost_flow(Vertex, Vertex, Flow, MinCostFlow = MinCostFlow::PrimalDual) const;
+  Cost network_simplex(Vertex, Vertex, Flow, std::vector<Flow>&, std::vector<Cost>&) const;
+  CostCurve minimum_cost_curve(Vertex, Vertex, Flow) const;
+  GomoryHuTree<Flow> gomory_hu_tree(int = 1) const;
+  Flow warm_maximum_flow(Vertex, Vertex);
+  Cost warm_minimum_cost_flow(Vertex, Vertex, Flow);
+  Flow flow(int) const;
  private:
+  // 始点は隣接リストの添字から分かるので持たない (long long で 24 bytes)
   struct Edge {
-    Vertex from, to;
+    Vertex to;
+    int rev;
     Flow capacity;
     Cost cost;
-    int rev;
-    Edge(Vertex from, Vertex to, Flow capacity, Cost cost, int rev) : from(from), to(to), capacity(capacity), cost(cost), rev(rev) {}
+    Edge(Vertex to, int rev, Flow capacity, Cost cost) : to(to), rev(rev), capacity(capacity), cost(cost) {}
+  };
+  using Residue = std::vector<std::vector<Edge>>;
+  // 隣接リストを一列に並べた残余グラフ (CSR)
+  //   頂点 v の辺は edge[start[v]], ..., edge[start[v + 1] - 1]
+  //   隣接リスト上の位置を保つので, 逆辺は residue[e.to][e.rev] で Residue と同じく参照できる
+  struct CSR {
+    std::vector<int> start;
+    std::vector<Edge> edge;
+    void assign(const Residue& G) {
+      start.resize(G.size() + 1);
+      edge.clear();
+      for(std::size_t v = 0; v < G.size(); ++v) {
+        start[v] = edge.size();
+        edge.insert(std::end(edge), std::begin(G[v]), std::end(G[v]));
+      }
+      start[G.size()] = edge.size();
+    }
+    std::span<Edge> operator[](Vertex v) {return {edge.data() + start[v], edge.data() + start[v + 1]};}
+    std::span<const Edge> operator[](Vertex v) const {return {edge.data() + start[v], edge.data() + start[v + 1]};}
+  };
+  template<class R> Flow Dinic(R&, Vertex, Vertex, Flow) const;
+  Flow HLPP(Vertex, Vertex) const;
+  Cost PrimalDual(Vertex, Vertex, Flow, CostCurve* = nullptr) const;
+  Cost CostScaling(Vertex, Vertex, Flow) const;
+  // ウォームスタート用の状態
+  struct Warm {
+    Residue residue;                    // 残余グラフ
+    std::vector<Cost> h;                // ポテンシャル (最小費用流モードのみ)
+    std::vector<Flow> excess;           // 各頂点の超過量 (修復後は source, sink 以外 0)
+    std::vector<Vertex> dirty;          // 超過量が 0 でなくなった可能性のある頂点
+    std::vector<Cost> dist;             // 探索用 (visited に入っている頂点だけ初期化し直す)
+    std::vector<Vertex> prev, visited;
+    std::vector<int> edge;
+    Vertex source = -1, sink = -1;
+    bool cost = false;                  // 最小費用流モードかどうか
+    Flow flow = 0;                      // 現在の流量
+    Cost total = 0;                     // 現在の費用
   };
+  void warm_start(Vertex, Vertex, bool);
+  void push(Vertex, Edge&, Flow);
+  Vertex search(const std::vector<Vertex>&, const std::function<bool(Vertex)>&);
+  Vertex augment(Vertex, Flow);
+  void repair();
   int size_;
-  std::vector<std::vector<Edge>> edge_;
+  Residue edge_;
+  std::vector<std::pair<Vertex, int>> id_;  // 辺番号 → (始点, 隣接リスト上の位置)
+  Warm warm_;
 };
 
 // コンストラクタ
-FlowNetwork::FlowNetwork(int n) : size_(n), edge_(n) {}
+template<std::integral Flow, std::integral Cost> FlowNetwork<Flow, Cost>::FlowNetwork(int n) : size_(n), edge_(n) {}
 
 // 辺を追加; 容量0コスト-cの逆辺も追加する
-void FlowNetwork::insert(Vertex from, Vertex to, Flow capacity = 0, Cost cost = 0) {
-  edge_.at(from).emplace_back(from, to, capacity, cost, edge_.at(to).size());
-  edge_.at(to).emplace_back(to, from, 0, -cost, edge_.at(from).size() - 1);
+//   戻り値は辺番号 (追加した順に 0, 1, ...)
+//   ウォームスタートの状態があれば残余グラフにも追加する
+template<std::integral Flow, std::integral Cost> int FlowNetwork<Flow, Cost>::insert(Vertex from, Vertex to, Flow capacity, Cost cost) {
+  id_.emplace_back(from, edge_.at(from).size());
+  edge_.at(from).emplace_back(to, edge_.at(to).size() + (from == to), capacity, cost);
+  edge_.at(to).emplace_back(from, edge_.at(from).size() - 1, 0, -cost);
+  if(~warm_.source) {
+    warm_.residue[from].emplace_back(edge_[from][id_.back().second]);
+    warm_.residue[to].emplace_back(edge_[to].back());
+    change(id_.size() - 1, capacity);
+  }
+  return id_.size() - 1;
+}
+
+// 辺の容量を変更
+//   ウォームスタートの状態があれば, 変更に関わる部分だけフローを修復する
+//     容量が流量を下回った場合: 超えた分を押し戻し, 両端の過不足を別経路か source, sink へ流し直す
+//     最小費用流モードで被約費用が負の辺の容量が増えた場合: 増えた分を飽和させ, 両端の過不足を同様に流し直す
+template<std::integral Flow, std::integral Cost> void FlowNetwork<Flow, Cost>::change(int id, Flow capacity) {
+  auto [from, i] = id_.at(id);
+  edge_[from][i].capacity = capacity;
+  if(warm_.source == -1) return;
+  auto& e = warm_.residue[from][i];
+  auto& r = warm_.residue[e.to][e.rev];
+  if(capacity < r.capacity) push(e.to, r, r.capacity - capacity);
+  e.capacity = capacity - r.capacity;
+  if(warm_.cost && from != e.to && 0 < e.capacity && e.cost + warm_.h[from] - warm_.h[e.to] < 0) push(from, e, e.capacity);
+  repair();
+}
+
+// ウォームスタートの状態における辺の流量
+template<std::integral Flow, std::integral Cost> Flow FlowNetwork<Flow, Cost>::flow(int id) const {
+  if(warm_.source == -1) return 0;
+  auto [from, i] = id_.at(id);
+  const auto& e = warm_.residue[from][i];
+  return warm_.residue[e.to][e.rev].capacity;
+}
+
+// 最大流
+//   Dinic:           疎なグラフ向け
+//   HLPP:            密なグラフ (画像セグメンテーション, 二部グラフの割当など) 向け
+//   CapacityScaling: 容量の大きなグラフ向け O(|E| |V| log U), U は容量の最大値
+template<std::integral Flow, std::integral Cost> Flow FlowNetwork<Flow, Cost>::maximum_flow(Vertex source, Vertex sink, MaxFlow algorithm) const {
+  if(algorithm == MaxFlow::HLPP) return HLPP(source, sink);
+  CSR residue;
+  residue.assign(edge_);
+  Flow delta = 1;
+  if(algorithm == MaxFlow::CapacityScaling) for(const auto& E: edge_) for(const auto& e: E) while(delta <= e.capacity / 2) delta *= 2;
+  Flow result = 0;
+  for(; 0 < delta; delta /= 2) result += Dinic(residue, source, sink, delta);
+  return result;
 }
 
-// 最大流: Dinic O(|E| |V|^2)
-Flow FlowNetwork::maximum_flow(Vertex source, Vertex sink) const {
-  std::vector<int> level;   // 各頂点に対するsourceからの距離
-  std::vector<int> itr;     // 各頂点に対して、itr[v]番目以前の辺は使っても無駄
-  auto residue = edge_;     // 残余グラフ
-  // sourceから各頂点までの距離を計算し、sinkまでの距離を返す
+// 最大流: Dinic O(|E| |V|^2), 容量がすべて 1 のとき O(|E| sqrt(|V|))
+//   残余容量が delta 以上の辺のみを使って流せるだけ流す (delta = 1 のとき通常の Dinic)
+//   R は Residue か CSR
+//   BFS: sink の距離が決まった時点で打ち切る (sink 以外の sink と同じ距離の頂点は使わない)
+//   DFS: source からのパスをスタックで持ち, sink に着いたら流して最初に飽和した辺の手前まで戻る
+//        行き止まりの頂点は距離を -1 にしてこのフェーズでは二度と訪れない
+template<std::integral Flow, std::integral Cost> template<class R> Flow FlowNetwork<Flow, Cost>::Dinic(R& residue, Vertex source, Vertex sink, Flow delta) const {
+  std::vector<int> level(size_);   // 各頂点に対するsourceからの距離
+  std::vector<int> itr(size_);     // 各頂点に対して、itr[v]番目以前の辺は使っても無駄
+  std::vector<Vertex> q(size_), path;
+  // sourceから各頂点までの距離を計算し、sinkに到達できるかを返す
   auto bfs = [&]() {
-    level.assign(size_, -1);
-    level.at(source) = 0;
-    std::queue<int> q;
-    q.push(source);
+    std::fill(std::begin(level), std::end(level), -1);
+    level[source] = 0;
+    int head = 0, tail = 0;
+    q[tail++] = source;
+    while(head < tail) {
+      auto v = q[head++];
+      for(const auto& e: residue[v]) if(level[e.to] == -1 && delta <= e.capacity) {
+        level[e.to] = level[v] + 1;
+        if(e.to == sink) return true;
+        q[tail++] = e.to;
+      }
+    }
+    return false;
+  };
+  Flow result = 0;
+  while(bfs()) {
+    std::fill(std::begin(itr), std::end(itr), 0);
+    path.assign(1, source);
+    while(!path.empty()) {
+      auto v = path.back();
+      if(v == sink) {
+        Flow f = FLOW_INF;
+        for(std::size_t i = 0; i + 1 < path.size(); ++i) f = std::min(f, residue[path[i]][itr[path[i]]].capacity);
+        std::size_t back = path.size() - 1;
+        for(std::size_t i = 0; i + 1 < path.size(); ++i) {
+          auto& e = residue[path[i]][itr[path[i]]];
+          e.capacity -= f;
+          residue[e.to][e.rev].capacity += f;
+          if(e.capacity < delta) back = std::min(back, i);
+        }
+        result += f;
+        path.resize(back + 1);
+        continue;
+      }
+      auto adj = residue[v];
+      auto& i = itr[v];
+      for(; i < int(adj.size()); ++i) {
+        const auto& e = adj[i];
+        if(delta <= e.capacity && level[e.to] == level[v] + 1 && (e.to == sink || level[e.to] < level[sink])) break;
+      }
+      if(i < int(adj.size())) {
+        path.emplace_back(adj[i].to);
+      } else {
+        level[v] = -1;
+        path.pop_back();
+        if(!path.empty()) ++itr[path.back()];
+      }
+    }
+  }
+  return result;
+}
+
+// 最大流: Highest-Label Push-Relabel O(|V|^2 sqrt(|E|))
+//   活性頂点を高さごとのバケットで管理し, 最も高い頂点から discharge する
+//   global relabeling: |V| 回 relabel するごとに sink からの逆 BFS で高さを正確な距離に戻す
+//   gap heuristic:     高さ h の頂点がなくなったら, h より高い頂点は sink に到達不能なので高さを |V| にする
+//   第一段階 (preflow) のみを行い, sink に溜まった超過量を最大流の値として返す
+template<std::integral Flow, std::integral Cost> Flow FlowNetwork<Flow, Cost>::HLPP(Vertex source, Vertex sink) const {
+  const int n = size_;
+  auto residue = edge_;                           // 残余グラフ
+  std::vector<Flow> excess(n, 0);                 // 各頂点の超過量
+  std::vector<int> height(n, n), itr(n, 0);       // 高さ (n 以上は sink に到達不能), 次に見る辺
+  std::vector<std::vector<Vertex>> active(n);     // 高さごとの活性頂点
+  std::vector<Vertex> head(n, -1), next(n), prev(n);  // 高さごとの頂点の双方向リスト (gap 用)
+  int top = 0, highest = 0;                       // 活性頂点の最大の高さ, 頂点の最大の高さ
+  auto link = [&](Vertex v) {
+    auto h = height[v];
+    prev[v] = -1;
+    next[v] = head[h];
+    if(~head[h]) prev[head[h]] = v;
+    head[h] = v;
+    highest = std::max(highest, h);
+  };
+  auto unlink = [&](Vertex v) {
+    if(~prev[v]) next[prev[v]] = next[v];
+    else         head[height[v]] = next[v];
+    if(~next[v]) prev[next[v]] = prev[v];
+  };
+  auto activate = [&](Vertex v) {
+    if(v == sink || n <= height[v]) return;
+    active[height[v]].emplace_back(v);
+    top = std::max(top, height[v]);
+  };
+  // sink からの逆 BFS で高さを計算し直す
+  auto global_relabel = [&]() {
+    height.assign(n, n);
+    head.assign(n, -1);
+    for(auto& list: active) list.clear();
+    top = highest = 0;
+    height[sink] = 0;
+    std::queue<Vertex> q;
+    q.push(sink);
     while(!q.empty()) {
       auto v = q.front();
       q.pop();
-      for(const auto& e: residue.at(v)) if(!~level.at(e.to)) if(0 < e.capacity) {
-        level.at(e.to) = level.at(e.from) + 1;
+      link(v);
+      for(const auto& e: residue[v]) if(e.to != source && height[e.to] == n && 0 < residue[e.to][e.rev].capacity) {
+        height[e.to] = height[v] + 1;
         q.push(e.to);
       }
     }
-    return level.at(sink);
+    for(Vertex v = 0; v < n; ++v) if(0 < excess[v]) activate(v);
+    itr.assign(n, 0);
   };
-  // バックトラックを利用してフローを流す
-  std::function<Flow(Vertex, Flow)> dfs = [&](Vertex v, Flow cur) {
-    if(v == sink) return cur;
-    for(auto& i = itr.at(v); i < residue.at(v).size(); ++i) {
-      auto& e = residue.at(v).at(i);
-      if(level.at(e.from) < level.at(e.to)) if(0 < e.capacity) {
-        auto f = dfs(e.to, std::min(cur, e.capacity));
-        if(f == 0) continue;
+  // 高さを上げる; gap が生じた場合は gap より高い頂点をすべて取り除く
+  auto relabel = [&](Vertex v) {
+    auto h = height[v];
+    unlink(v);
+    if(head[h] == -1) {
+      for(auto g = h + 1; g <= highest; ++g) {
+        for(auto u = head[g]; ~u; u = next[u]) height[u] = n;
+        head[g] = -1;
+        active[g].clear();
+      }
+      highest = h - 1;
+      height[v] = n;
+      return;
+    }
+    height[v] = n;
+    for(const auto& e: residue[v]) if(0 < e.capacity) height[v] = std::min(height[v], height[e.to] + 1);
+    if(height[v] < n) link(v);
+    itr[v] = 0;
+  };
+  // 超過量がなくなるか sink に到達不能になるまで流す
+  auto discharge = [&](Vertex v) {
+    while(0 < excess[v]) {
+      if(itr[v] == int(residue[v].size())) {
+        relabel(v);
+        if(n <= height[v]) return;
+        continue;
+      }
+      auto& e = residue[v][itr[v]];
+      if(0 < e.capacity && height[v] == height[e.to] + 1) {
+        auto f = std::min(excess[v], e.capacity);
+        if(excess[e.to] == 0) activate(e.to);
         e.capacity -= f;
-        residue.at(e.to).at(e.rev).capacity += f;
-        return f;
+        residue[e.to][e.rev].capacity += f;
+        excess[v] -= f;
+        excess[e.to] += f;
+      } else {
+        ++itr[v];
       }
     }
-    return Flow(0);
   };
-  // Dinic
-  Flow result = 0;
-  while(~bfs()) {
-    itr.assign(size_, 0);
-    while(auto f = dfs(source, FLOW_INF)) result += f;
+  // source から出る辺をすべて飽和させる
+  for(auto& e: residue[source]) if(0 < e.capacity) {
+    excess[e.to] += e.capacity;
+    residue[e.to][e.rev].capacity += e.capacity;
+    e.capacity = 0;
   }
-  return result;
+  global_relabel();
+  int relabels = 0;
+  while(true) {
+    while(0 <= top && active[top].empty()) --top;
+    if(top < 0) break;
+    auto v = active[top].back();
+    active[top].pop_back();
+    auto h = height[v];
+    discharge(v);
+    if(height[v] != h && n <= ++relabels) {
+      global_relabel();
+      relabels = 0;
+    }
+  }
+  return excess[sink];
+}
+
+// 最小費用流
+//   流量 f を流せない場合は COST_INF を返す
+//   PrimalDual:  f が小さいとき向け
+//   CostScaling: f が大きいとき向け (計算量が f に依存しない)
+//   NetworkSimplex: 中規模のグラフ向け (実用上最も速いことが多い)
+template<std::integral Flow, std::integral Cost> Cost FlowNetwork<Flow, Cost>::minimum_cost_flow(Vertex source, Vertex sink, Flow f, MinCostFlow algorithm) const {
+  std::vector<Flow> flow;
+  std::vector<Cost> potential;
+  switch(algorithm) {
+    case MinCostFlow::PrimalDual:     return PrimalDual(source, sink, f);
+    case MinCostFlow::CostScaling:    return CostScaling(source, sink, f);
+    case MinCostFlow::NetworkSimplex: return network_simplex(source, sink, f, flow, potential);
+  }
+  assert(false);
+  return COST_INF;
+}
+
+// 流量 F 以下の最小費用流の費用関数 O(F |E| log |V|)
+//   Primal-Dual は単位費用の小さい順に増加路を使うので, 一度の実行で全ての折れ点が得られる
+//   F まで流せない場合は, 流せる最大の流量までの関数を返す
+template<std::integral Flow, std::integral Cost> typename FlowNetwork<Flow, Cost>::CostCurve FlowNetwork<Flow, Cost>::minimum_cost_curve(Vertex source, Vertex sink, Flow F) const {
+  CostCurve curve;
+  PrimalDual(source, sink, F, &curve);
+  return curve;
 }
 
 // 最小費用流: Primal-Dual O(F |E| log |V|)
-Cost FlowNetwork::minimum_cost_flow(Vertex source, Vertex sink, Flow f) const {
+//   curve が与えられた場合は, 増加路ごとに (流量, 費用) を記録する (単位費用が変わらない間は折れ点をまとめる)
+template<std::integral Flow, std::integral Cost> Cost FlowNetwork<Flow, Cost>::PrimalDual(Vertex source, Vertex sink, Flow f, CostCurve* curve) const {
   std::vector<Cost> h(size_, 0);  // 残余グラフにおけるsourceから各頂点までの最短距離
   auto residue = edge_;           // 残余グラフ
-  Flow result = 0;
+  Cost result = 0;
+  Flow total = 0;
+  if(curve) curve->flow = {0}, curve->cost = {0};
   // 負辺を含むグラフに対応するため, ポテンシャルの初期値を計算
-  for(const auto& E: edge_) for(const auto& e: E) if(0 < e.capacity) h[e.to] = std::min(h[e.to], h[e.from] + e.cost);
+  for(Vertex v = 0; v < size_; ++v) for(const auto& e: edge_[v]) if(0 < e.capacity) h[e.to] = std::min(h[e.to], h[v] + e.cost);
   while(0 < f) {
     // sourceからDijkstra
     using Node = std::tuple<Cost, Vertex>;
     std::vector<Cost> dist(size_, COST_INF);
     dist.at(source) = 0;
-    std::vector<Edge*> prev(size_, nullptr);
+    std::vector<Vertex> prev(size_, -1);  // 最短路木における親
+    std::vector<Edge*> edge(size_, nullptr);  // 最短路木における親からの辺
     std::priority_queue<Node, std::vector<Node>, std::greater<Node>> q;
     q.emplace(0, source);
     while(!q.empty()) {
@@ -115,9 +404,10 @@ Cost FlowNetwork::minimum_cost_flow(Vertex source, Vertex sink, Flow f) const {
       if(dist.at(v) < c) continue;
       for(auto& e: residue.at(v)) {
         if(e.capacity <= 0) continue;
-        if(dist.at(e.to) <= dist.at(e.from) + e.cost + h.at(e.from) - h.at(e.to)) continue;
-        dist.at(e.to) = dist.at(e.from) + e.cost + h.at(e.from) - h.at(e.to);
-        prev.at(e.to) = &e;
+        if(dist.at(e.to) <= dist.at(v) + e.cost + h.at(v) - h.at(e.to)) continue;
+        dist.at(e.to) = dist.at(v) + e.cost + h.at(v) - h.at(e.to);
+        prev.at(e.to) = v;
+        edge.at(e.to) = &e;
         q.emplace(dist.at(e.to), e.to);
       }
     }
@@ -127,39 +417,559 @@ Cost FlowNetwork::minimum_cost_flow(Vertex source, Vertex sink, Flow f) const {
     for(int v = 0; v < size_; ++v) if(dist.at(v) != COST_INF) h.at(v) += dist.at(v);
     // 流せるだけ流す
     Flow add = f;
-    for(Vertex v = sink; v != source; v = prev.at(v)->from) add = std::min(add, prev.at(v)->capacity);
+    for(Vertex v = sink; v != source; v = prev.at(v)) add = std::min(add, edge.at(v)->capacity);
     f -= add;
+    total += add;
     result += add * h.at(sink);
-    for(Vertex v = sink; v != source; v = prev.at(v)->from) {
-      prev.at(v)->capacity -= add;
-      residue.at(prev.at(v)->to).at(prev.at(v)->rev).capacity += add;
+    if(curve) {
+      auto& [F, C] = *curve;
+      if(1 < F.size() && C.back() - C.end()[-2] == h.at(sink) * (F.back() - F.end()[-2])) F.pop_back(), C.pop_back();
+      F.emplace_back(total);
+      C.emplace_back(result);
+    }
+    for(Vertex v = sink; v != source; v = prev.at(v)) {
+      edge.at(v)->capacity -= add;
+      residue.at(v).at(edge.at(v)->rev).capacity += add;
+    }
+  }
+  return result;
+}
+
+// 最小費用流: Cost Scaling (Goldberg) O(|V|^2 |E| log (|V| C)), C は費用の絶対値の最大値
+//   費用を (|V| + 1) 倍して扱い, ε-最適なフローを ε = C (|V| + 1) から 1 まで α 分の 1 ずつ改良する
+//     ε-最適: すべての残余辺について被約費用 cost + p[from] - p[to] が -ε 以上
+//     費用が整数なので, (|V| + 1) 倍した費用で 1-最適なフローは最適 (負閉路の費用が -1 より大きくなる)
+//   refine(ε): 被約費用が負の残余辺をすべて飽和させてから, 超過のある頂点を FIFO 順に push / relabel する
+//     push:    被約費用が負の残余辺に沿って流す
+//     relabel: p[v] を, 出ていく残余辺の被約費用の最小値がちょうど -ε になるまで下げる
+//   あらかじめ最大流で f を流せることを確かめておく (流せないと relabel が止まらない)
+template<std::integral Flow, std::integral Cost> Cost FlowNetwork<Flow, Cost>::CostScaling(Vertex source, Vertex sink, Flow f) const {
+  if(maximum_flow(source, sink) < f) return COST_INF;
+  const int n = size_;
+  const Cost alpha = 16, scale = n + 1;
+  auto residue = edge_;                     // 残余グラフ
+  std::vector<Flow> excess(n, 0);           // 各頂点の超過量
+  std::vector<Cost> p(n, 0);                // ポテンシャル
+  std::vector<int> itr(n, 0);               // 次に見る辺
+  excess[source] += f;
+  excess[sink] -= f;
+  auto rc = [&](Vertex v, const Edge& e) {return e.cost * scale + p[v] - p[e.to];};
+  auto refine = [&](Cost eps) {
+    std::queue<Vertex> q;
+    for(Vertex v = 0; v < n; ++v) for(auto& e: residue[v]) if(0 < e.capacity && rc(v, e) < 0) {
+      excess[v] -= e.capacity;
+      excess[e.to] += e.capacity;
+      residue[e.to][e.rev].capacity += e.capacity;
+      e.capacity = 0;
+    }
+    for(Vertex v = 0; v < n; ++v) if(0 < excess[v]) q.push(v);
+    itr.assign(n, 0);
+    while(!q.empty()) {
+      auto v = q.front();
+      q.pop();
+      while(0 < excess[v]) {
+        if(itr[v] == int(residue[v].size())) {
+          auto h = std::numeric_limits<Cost>::min();
+          for(const auto& e: residue[v]) if(0 < e.capacity) h = std::max(h, p[e.to] - e.cost * scale);
+          p[v] = h - eps;
+          itr[v] = 0;
+          continue;
+        }
+        auto& e = residue[v][itr[v]];
+        if(0 < e.capacity && rc(v, e) < 0) {
+          auto d = std::min(excess[v], e.capacity);
+          if(excess[e.to] <= 0 && 0 < excess[e.to] + d) q.push(e.to);
+          e.capacity -= d;
+          residue[e.to][e.rev].capacity += d;
+          excess[v] -= d;
+          excess[e.to] += d;
+        } else {
+          ++itr[v];
+        }
+      }
+    }
+  };
+  Cost eps = 1;
+  for(const auto& E: edge_) for(const auto& e: E) eps = std::max(eps, (e.cost < 0 ? -e.cost : e.cost) * scale);
+  do {
+    eps = std::max<Cost>(1, eps / alpha);
+    refine(eps);
+  } while(1 < eps);
+  Cost result = 0;
+  for(auto [v, i]: id_) result += (edge_[v][i].capacity - residue[v][i].capacity) * edge_[v][i].cost;
+  return result;
+}
+
+// 最小費用流: Network Simplex (Block Search Pivot)
+//   解説: LEMON の NetworkSimplex
+//   flow[i]:      i 番目に追加した辺の流量
+//   potential[v]: 双対変数; 流量が容量未満の辺は cost + potential[from] - potential[to] >= 0,
+//                           流量が正の辺は cost + potential[from] - potential[to] <= 0 をみたす
+//   根 (頂点番号 |V|) と各頂点を結ぶ人工辺を加えた全域木を基底とし, 木は以下の配列で表す
+//     parent[v]:   親
+//     pred[v]:     親との間の辺
+//     depth[v]:    深さ
+//     thread[v]:   行きがけ順で次の頂点 (最後の頂点の次は根)
+//     last[v]:     v を根とする部分木の行きがけ順で最後の頂点
+//     size[v]:     v を根とする部分木の頂点数
+//   入る辺は sqrt(辺数) 本ずつのブロックの中で被約費用が最も負のものを選ぶ
+//   出る辺は閉路の中で最初に容量がなくなる辺を選ぶ (強実行可能な木を保つ)
+template<std::integral Flow, std::integral Cost> Cost FlowNetwork<Flow, Cost>::network_simplex(Vertex source, Vertex sink, Flow f, std::vector<Flow>& flow, std::vector<Cost>& potential) const {
+  const int n = size_, m = id_.size(), root = n, all = m + n;
+  enum State : signed char {UPPER = -1, TREE = 0, LOWER = 1};
+  std::vector<Vertex> src(all), dst(all);
+  std::vector<Flow> cap(all), x(all, 0);
+  std::vector<Cost> cost(all), pi(n + 1, 0);
+  std::vector<signed char> state(all, LOWER);
+  std::vector<Vertex> parent(n + 1, root), thread(n + 1), rev_thread(n + 1), last(n + 1);
+  std::vector<int> pred(n + 1, -1), depth(n + 1, 1), size(n + 1, 1);
+  Cost art = 1;
+  for(int i = 0; i < m; ++i) {
+    auto [v, j] = id_[i];
+    src[i] = v;
+    dst[i] = edge_[v][j].to;
+    cap[i] = edge_[v][j].capacity;
+    cost[i] = edge_[v][j].cost;
+    art = std::max(art, (cost[i] < 0 ? -cost[i] : cost[i]) + 1);
+  }
+  art *= n + 1;
+  // 初期基底: 供給のある頂点 (と 0 の頂点) は根へ, 需要のある頂点は根から人工辺で流す
+  std::vector<Flow> b(n, 0);
+  if(source != sink) b[source] += f, b[sink] -= f;
+  for(Vertex v = 0; v < n; ++v) {
+    auto e = m + v;
+    state[e] = TREE;
+    cap[e] = FLOW_INF;
+    cost[e] = art;
+    if(0 <= b[v]) src[e] = v, dst[e] = root, x[e] = b[v], pi[v] = -art;
+    else          src[e] = root, dst[e] = v, x[e] = -b[v], pi[v] = art;
+    pred[v] = e;
+    thread[v] = v + 1 < n ? v + 1 : root;
+    rev_thread[v] = v ? v - 1 : root;
+    last[v] = v;
+  }
+  parent[root] = -1;
+  depth[root] = 0;
+  size[root] = n + 1;
+  thread[root] = n ? 0 : root;
+  rev_thread[root] = n ? n - 1 : root;
+  last[root] = n ? n - 1 : root;
+  auto reduced = [&](int e) {return state[e] * (cost[e] + pi[src[e]] - pi[dst[e]]);};
+  const int block = std::max(10, int(std::sqrt(double(all))));
+  int next = 0;
+  // 入る辺を探す; 見つからなければ -1
+  auto find_entering = [&]() {
+    int in = -1;
+    Cost min = 0;
+    for(int cnt = 0, k = 0; k < all; ++k) {
+      auto e = (next + k) % all;
+      auto c = reduced(e);
+      if(c < min) min = c, in = e;
+      if(++cnt == block) {
+        if(~in) {next = (e + 1) % all; return in;}
+        cnt = 0;
+      }
+    }
+    return in;
+  };
+  std::vector<Vertex> path, order;
+  while(true) {
+    auto in = find_entering();
+    if(in == -1) break;
+    // 閉路を求める
+    auto first = state[in] == LOWER ? src[in] : dst[in];
+    auto second = state[in] == LOWER ? dst[in] : src[in];
+    auto join = first;
+    for(auto u = second; join != u; ) {
+      if(depth[join] < depth[u]) u = parent[u];
+      else if(depth[u] < depth[join]) join = parent[join];
+      else join = parent[join], u = parent[u];
+    }
+    // 出る辺を求める
+    auto delta = cap[in];
+    int result = 0;
+    Vertex out = -1;
+    for(auto u = first; u != join; u = parent[u]) {
+      auto e = pred[u];
+      auto d = src[e] == u ? x[e] : cap[e] - x[e];
+      if(d < delta) delta = d, out = u, result = 1;
+    }
+    for(auto u = second; u != join; u = parent[u]) {
+      auto e = pred[u];
+      auto d = src[e] == u ? cap[e] - x[e] : x[e];
+      if(d <= delta) delta = d, out = u, result = 2;
+    }
+    // 閉路に沿って流す
+    if(0 < delta) {
+      auto val = state[in] * delta;
+      x[in] += val;
+      for(auto u = src[in]; u != join; u = parent[u]) x[pred[u]] += src[pred[u]] == u ? -val : val;
+      for(auto u = dst[in]; u != join; u = parent[u]) x[pred[u]] += src[pred[u]] == u ? val : -val;
+    }
+    if(result == 0) {
+      state[in] = -state[in];
+      continue;
+    }
+    // 木を更新: out を根とする部分木 S を切り離し, u_in を根として v_in の下につなぎ直す
+    auto e_out = pred[out];
+    state[e_out] = x[e_out] == 0 ? LOWER : UPPER;
+    state[in] = TREE;
+    auto u_in = result == 1 ? first : second, v_in = result == 1 ? second : first;
+    path.clear();
+    for(auto u = u_in; ; u = parent[u]) {
+      path.emplace_back(u);
+      if(u == out) break;
+    }
+    // S の新しい行きがけ順
+    order.clear();
+    for(std::size_t i = 0; i < path.size(); ++i) {
+      auto u = path[i];
+      order.emplace_back(u);
+      for(auto w = thread[u]; ; ) {
+        if(0 < i && w == path[i - 1]) w = thread[last[w]];
+        if(w == thread[last[u]]) break;
+        order.emplace_back(w);
+        w = thread[w];
+      }
+    }
+    // S を thread から取り除く
+    auto S = size[out], before = rev_thread[out], after = thread[last[out]], old_last = last[out];
+    thread[before] = after;
+    rev_thread[after] = before;
+    for(auto a = parent[out]; ~a; a = parent[a]) {
+      size[a] -= S;
+      if(last[a] == old_last) last[a] = before;
+    }
+    // 根から out までの向きを反転
+    for(auto i = path.size() - 1; 0 < i; --i) {
+      parent[path[i]] = path[i - 1];
+      pred[path[i]] = pred[path[i - 1]];
+      size[path[i]] = S - size[path[i - 1]];
+    }
+    parent[u_in] = v_in;
+    pred[u_in] = in;
+    size[u_in] = S;
+    for(auto u: path) last[u] = order.back();
+    // S を v_in の直後に挿入
+    for(std::size_t j = 0; j + 1 < order.size(); ++j) thread[order[j]] = order[j + 1], rev_thread[order[j + 1]] = order[j];
+    auto nex = thread[v_in];
+    thread[v_in] = order.front();
+    rev_thread[order.front()] = v_in;
+    thread[order.back()] = nex;
+    rev_thread[nex] = order.back();
+    if(last[v_in] == v_in) for(auto a = v_in; ~a && last[a] == v_in; a = parent[a]) last[a] = order.back();
+    for(auto a = v_in; ~a; a = parent[a]) size[a] += S;
+    // S の深さとポテンシャルを更新
+    auto sigma = (src[in] == u_in ? pi[v_in] - cost[in] : pi[v_in] + cost[in]) - pi[u_in];
+    for(auto u: order) {
+      depth[u] = depth[parent[u]] + 1;
+      pi[u] += sigma;
     }
   }
+  for(Vertex v = 0; v < n; ++v) if(0 < x[m + v]) return COST_INF;
+  Cost result = 0;
+  for(int i = 0; i < m; ++i) result += x[i] * cost[i];
+  flow.assign(std::begin(x), std::begin(x) + m);
+  potential.assign(std::begin(pi), std::begin(pi) + n);
   return result;
 }
 
+// Gomory-Hu 木: Gusfield O(|V| * 最大流)
+//   無向グラフは両方向に辺を追加しておくこと
+//   頂点 s = 1, ..., |V|-1 について parent[s] との最小カットを求め, s 側にある s より大きい頂点で
+//   parent が同じものの parent を s に付け替える
+//   threads 個の s について, その時点の parent[s] との最大流を並列に計算してから順に適用する
+//     適用時に parent[s] が (同じバッチ内の付け替えで) 変わっていれば計算し直すので, 結果は逐次版と一致する
+//   スレッドは一度だけ立てて std::barrier でバッチごとに待ち合わせ, 残余グラフの領域はスレッドごとに使い回す
+//   ※ threads > 1 のときは -pthread を付けてコンパイルする
+template<std::integral Flow, std::integral Cost> GomoryHuTree<Flow> FlowNetwork<Flow, Cost>::gomory_hu_tree(int threads) const {
+  const int n = size_;
+  threads = std::max(1, threads);
+  std::vector<Vertex> parent(n, 0);
+  std::vector<Flow> weight(n, 0);
+  std::vector<CSR> residue(threads);
+  std::vector<std::vector<bool>> side(threads);
+  std::vector<Vertex> target(threads);
+  std::vector<Flow> value(threads);
+  // s と t の最小カットの値と s 側の頂点集合を計算する
+  auto cut = [&](int k, Vertex s, Vertex t) {
+    residue[k].assign(edge_);
+    target[k] = t;
+    value[k] = Dinic(residue[k], s, t, 1);
+    side[k].assign(n, false);
+    side[k][s] = true;
+    std::queue<Vertex> q;
+    q.push(s);
+    while(!q.empty()) {
+      auto v = q.front();
+      q.pop();
+      for(const auto& e: residue[k][v]) if(0 < e.capacity && !side[k][e.to]) {
+        side[k][e.to] = true;
+        q.push(e.to);
+      }
+    }
+  };
+  // 全スレッドのカットが揃ったら順に適用して, 次のバッチへ進む
+  Vertex first = 1;
+  auto apply = [&]() noexcept {
+    auto last = std::min(n, first + threads);
+    for(auto s = first; s < last; ++s) {
+      auto k = s - first;
+      if(target[k] != parent[s]) cut(k, s, parent[s]);
+      weight[s] = value[k];
+      for(auto v = s + 1; v < n; ++v) if(side[k][v] && parent[v] == parent[s]) parent[v] = s;
+    }
+    first = last;
+  };
+  // スレッドは最初に一度だけ立て, バッチごとに barrier で待ち合わせる
+  std::barrier sync(threads, apply);
+  auto run = [&](int k) {
+    while(first < n) {
+      if(first + k < n) cut(k, first + k, parent[first + k]);
+      sync.arrive_and_wait();
+    }
+  };
+  if(threads == 1) {
+    run(0);
+  } else {
+    std::vector<std::thread> pool;
+    for(int k = 0; k < threads; ++k) pool.emplace_back(run, k);
+    for(auto& t: pool) t.join();
+  }
+  return GomoryHuTree<Flow>(parent, weight);
+}
+
+// ウォームスタートの状態を初期化する; 2 回目以降は source, sink, モードが同じであることを確認するだけ
+template<std::integral Flow, std::integral Cost> void FlowNetwork<Flow, Cost>::warm_start(Vertex source, Vertex sink, bool cost) {
+  if(~warm_.source) {
+    assert(warm_.source == source && warm_.sink == sink && warm_.cost == cost);
+    return;
+  }
+  warm_.residue = edge_;
+  warm_.h.assign(size_, 0);
+  if(cost) for(Vertex v = 0; v < size_; ++v) for(const auto& e: edge_[v]) if(0 < e.capacity) warm_.h[e.to] = std::min(warm_.h[e.to], warm_.h[v] + e.cost);
+  warm_.excess.assign(size_, 0);
+  warm_.dist.assign(size_, COST_INF);
+  warm_.prev.assign(size_, -1);
+  warm_.edge.assign(size_, -1);
+  warm_.source = source;
+  warm_.sink = sink;
+  warm_.cost = cost;
+}
+
+// 辺 e に沿って v から f だけ流す
+template<std::integral Flow, std::integral Cost> void FlowNetwork<Flow, Cost>::push(Vertex v, Edge& e, Flow f) {
+  e.capacity -= f;
+  warm_.residue[e.to][e.rev].capacity += f;
+  warm_.excess[v] -= f;
+  warm_.excess[e.to] += f;
+  warm_.total += f * e.cost;
+  if(v == warm_.source) warm_.flow += f;
+  if(e.to == warm_.source) warm_.flow -= f;
+  warm_.dirty.emplace_back(v);
+  warm_.dirty.emplace_back(e.to);
+}
+
+// sources から残余グラフを探索し, 最初に見つかった target を返す (見つからなければ -1)
+//   最小費用流モード: 被約費用で Dijkstra し, 訪れた頂点のポテンシャルだけを更新する
+//     未確定の頂点には一律に target までの距離 D を足すべきだが, 定数差は被約費用に影響しないので
+//     訪れた頂点に min(dist, D) - D を足すことで済ませる
+//   最大流モード:     辺の長さをすべて 1 として探索する
+template<std::integral Flow, std::integral Cost> Vertex FlowNetwork<Flow, Cost>::search(const std::vector<Vertex>& sources, const std::function<bool(Vertex)>& target) {
+  auto& w = warm_;
+  for(auto v: w.visited) w.dist[v] = COST_INF;
+  w.visited.clear();
+  using Node = std::tuple<Cost, Vertex>;
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> q;
+  for(auto v: sources) if(w.dist[v] != 0) {
+    w.dist[v] = 0;
+    w.prev[v] = -1;
+    w.visited.emplace_back(v);
+    q.emplace(0, v);
+  }
+  while(!q.empty()) {
+    auto [c, v] = q.top();
+    q.pop();
+    if(w.dist[v] < c) continue;
+    if(target(v)) {
+      if(w.cost) for(auto u: w.visited) w.h[u] += std::min(w.dist[u], c) - c;
+      return v;
+    }
+    for(int i = 0; i < int(w.residue[v].size()); ++i) {
+      const auto& e = w.residue[v][i];
+      if(e.capacity <= 0 || e.to == v) continue;
+      auto d = c + (w.cost ? e.cost + w.h[v] - w.h[e.to] : 1);
+      if(w.dist[e.to] <= d) continue;
+      if(w.dist[e.to] == COST_INF) w.visited.emplace_back(e.to);
+      w.dist[e.to] = d;
+      w.prev[e.to] = v;
+      w.edge[e.to] = i;
+      q.emplace(d, e.to);
+    }
+  }
+  return -1;
+}
+
+// 直前の search で見つかった経路に沿って, 経路の始点から t まで高々 f だけ流し, 経路の始点を返す
+template<std::integral Flow, std::integral Cost> Vertex FlowNetwork<Flow, Cost>::augment(Vertex t, Flow f) {
+  auto& w = warm_;
+  auto s = t;
+  for(; ~w.prev[s]; s = w.prev[s]) f = std::min(f, w.residue[w.prev[s]][w.edge[s]].capacity);
+  if(s != w.source && s != w.sink) f = std::min(f, w.excess[s]);
+  if(t != w.source && t != w.sink) f = std::min(f, -w.excess[t]);
+  for(auto v = t; ~w.prev[v]; v = w.prev[v]) push(w.prev[v], w.residue[w.prev[v]][w.edge[v]], f);
+  return s;
+}
+
+// source, sink 以外の頂点の過不足を解消する
+//   超過のある頂点から, 不足のある頂点か source, sink へ流す
+//   不足のある頂点へ, source か sink から流す
+//   探索は変更箇所の近くで打ち切られるので, 計算量はおおむね変更の大きさで決まる
+template<std::integral Flow, std::integral Cost> void FlowNetwork<Flow, Cost>::repair() {
+  auto& w = warm_;
+  auto terminal = [&](Vertex v) {return v == w.source || v == w.sink;};
+  std::vector<Vertex> sources;
+  while(true) {
+    sources.clear();
+    for(auto v: w.dirty) if(!terminal(v) && 0 < w.excess[v]) sources.emplace_back(v);
+    if(sources.empty()) break;
+    auto t = search(sources, [&](Vertex v) {return terminal(v) || w.excess[v] < 0;});
+    if(t == -1) break;
+    augment(t, FLOW_INF);
+  }
+  while(true) {
+    bool deficit = false;
+    for(auto v: w.dirty) if(!terminal(v) && w.excess[v] < 0) deficit = true;
+    if(!deficit) break;
+    auto t = search({w.source, w.sink}, [&](Vertex v) {return !terminal(v) && w.excess[v] < 0;});
+    if(t == -1) break;
+    augment(t, FLOW_INF);
+  }
+  w.dirty.clear();
+}
+
+// 最大流 (ウォームスタート)
+//   残余グラフを呼び出し間で保持し, 前回のフローから Dinic を再開する
+//   source, sink は初回の呼び出しで固定される
+template<std::integral Flow, std::integral Cost> Flow FlowNetwork<Flow, Cost>::warm_maximum_flow(Vertex source, Vertex sink) {
+  warm_start(source, sink, false);
+  repair();
+  return warm_.flow += Dinic(warm_.residue, source, sink, 1);
+}
+
+// 最小費用流 (ウォームスタート)
+//   残余グラフとポテンシャルを呼び出し間で保持し, 現在の流量から f まで最短路に沿って増減させる
+//   source, sink は初回の呼び出しで固定される
+//   流せない場合は COST_INF を返す (状態は最大まで流した状態になる)
+template<std::integral Flow, std::integral Cost> Cost FlowNetwork<Flow, Cost>::warm_minimum_cost_flow(Vertex source, Vertex sink, Flow f) {
+  warm_start(source, sink, true);
+  repair();
+  while(warm_.flow < f) {
+    if(search({source}, [&](Vertex v) {return v == sink;}) == -1) return COST_INF;
+    augment(sink, f - warm_.flow);
+  }
+  while(f < warm_.flow) {
+    if(search({sink}, [&](Vertex v) {return v == source;}) == -1) break;
+    augment(source, warm_.flow - f);
+  }
+  return warm_.total;
+}
+
+// Gomory-Hu 木 (FlowNetwork::gomory_hu_tree で構築)
+//   parent[v] < v (根は 0), weight[v] は v と parent[v] の最小カット
+//   任意の 2 頂点の最小カットは木上のパスにある辺の重みの最小値
+//   ダブリングで LCA を求めながらパス上の最小値を計算する
+//   計算量:
+//     構築       O(|V| log |V|)
+//     最小カット O(log |V|)
+template<std::integral Flow> class GomoryHuTree {
+ public:
+  GomoryHuTree(const std::vector<Vertex>& parent, const std::vector<Flow>& weight) : depth_(parent.size(), 0) {
+    const int n = parent.size();
+    int h = 1;
+    while((1 << h) < n) ++h;
+    up_.assign(h, std::vector<Vertex>(n, 0));
+    min_.assign(h, std::vector<Flow>(n, std::numeric_limits<Flow>::max()));
+    for(Vertex v = 1; v < n; ++v) {
+      up_[0][v] = parent[v];
+      min_[0][v] = weight[v];
+      depth_[v] = depth_[parent[v]] + 1;
+    }
+    for(int k = 0; k + 1 < h; ++k) for(Vertex v = 0; v < n; ++v) {
+      up_[k + 1][v] = up_[k][up_[k][v]];
+      min_[k + 1][v] = std::min(min_[k][v], min_[k][up_[k][v]]);
+    }
+  }
+  Flow minimum_cut(Vertex u, Vertex v) const {
+    auto result = std::numeric_limits<Flow>::max();
+    if(depth_[u] < depth_[v]) std::swap(u, v);
+    for(int k = up_.size() - 1; 0 <= k; --k) if(depth_[v] <= depth_[u] - (1 << k)) {
+      result = std::min(result, min_[k][u]);
+      u = up_[k][u];
+    }
+    if(u == v) return result;
+    for(int k = up_.size() - 1; 0 <= k; --k) if(up_[k][u] != up_[k][v]) {
+      result = std::min({result, min_[k][u], min_[k][v]});
+      u = up_[k][u];
+      v = up_[k][v];
+    }
+    return std::min({result, min_[0][u], min_[0][v]});
+  }
+ private:
+  std::vector<int> depth_;
+  std::vector<std::vector<Vertex>> up_;
+  std::vector<std::vector<Flow>> min_;
+};
+
 #include<bits/stdc++.h>
 using namespace std;
 int main() {
 //   // GRL_6_A
 //   int V, E;
 //   cin >> V >> E;
-//   FlowNetwork G(V);
+//   FlowNetwork<> G(V);
 //   for(int i = 0; i < E; ++i) {
-//     Vertex u, v; Flow c;
+//     Vertex u, v; long long c;
 //     cin >> u >> v >> c;
 //     G.insert(u, v, c);
 //   }
 //   cout << G.maximum_flow(0, V - 1) << endl;
+//   // ベンチマーク: 最小費用流 (PrimalDual / CostScaling / NetworkSimplex)
+//   //   輸送問題 100 x 100, 供給量 1e5 ~ 2e5:  PrimalDual 12ms,  CostScaling 3.8ms, NetworkSimplex 3.3ms
+//   //   割当問題 300 x 300:                   PrimalDual 262ms, CostScaling 89ms,  NetworkSimplex 84ms
+//   mt19937 rng(3);
+//   auto bench = [&](const FlowNetwork<>& G, int s, int t, long long F) {
+//     for(auto algorithm: {FlowNetwork<>::MinCostFlow::PrimalDual, FlowNetwork<>::MinCostFlow::CostScaling, FlowNetwork<>::MinCostFlow::NetworkSimplex}) {
+//       auto start = chrono::steady_clock::now();
+//       auto cost = G.minimum_cost_flow(s, t, F, algorithm);
+//       cout << cost << " " << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << "ms" << endl;
+//     }
+//   };
+//   {
+//     int S = 100, T = 100, n = S + T + 2;
+//     FlowNetwork<> G(n);
+//     long long F = 0;
+//     for(int i = 0; i < S; ++i) {auto a = 100000 + rng() % 100000; F += a; G.insert(0, 1 + i, a);}
+//     for(int j = 0; j < T; ++j) G.insert(1 + S + j, n - 1, 4000000);
+//     for(int i = 0; i < S; ++i) for(int j = 0; j < T; ++j) G.insert(1 + i, 1 + S + j, 1000000000, rng() % 1000);
+//     bench(G, 0, n - 1, F);
+//   }
+//   {
+//     int N = 300, n = 2 * N + 2;
+//     FlowNetwork<> G(n);
+//     for(int i = 0; i < N; ++i) G.insert(0, 1 + i, 1), G.insert(1 + N + i, n - 1, 1);
+//     for(int i = 0; i < N; ++i) for(int j = 0; j < N; ++j) G.insert(1 + i, 1 + N + j, 1, rng() % 10000);
+//     bench(G, 0, n - 1, N);
+//   }
   // GRL_6_B
   int V, E, F;
   cin >> V >> E >> F;
-  FlowNetwork G(V);
+  FlowNetwork<> G(V);
   for(int i = 0; i < E; ++i) {
-    Vertex u, v; Flow c; Cost d;
+    Vertex u, v; long long c, d;
     cin >> u >> v >> c >> d;
     G.insert(u, v, c, d);
   }
   auto ans = G.minimum_cost_flow(0, V - 1, F);
-  cout << (ans != COST_INF ? ans : -1) << endl;
+  cout << (ans != FlowNetwork<>::COST_INF ? ans : -1) << endl;
 }
@@ -1,11 +1,53 @@
 // 隣接リストで表現された無向グラフに対して
-// 最大独立集合のサイズを求める
+// 最大独立集合を求める
 
-// 計算量: O(1.381^|V| * |V|)
+// 分枝限定法 + 縮約 (branch and reduce)
+//   グラフは隣接行列を 64 bit 単位の bitset で持つ
+//   頂点の削除は巻き戻し用の記録 (trail) を残して次数を差分で更新するので, 分岐のたびにグラフを複製しない
+//   縮約規則 (根と各分岐で, 近傍が変わった頂点について不動点まで適用する)
+//     次数 0, 1: その頂点を採用する
+//     次数 2:    2 つの隣接頂点が隣接していればその頂点を採用し, そうでなければ 3 頂点を 1 頂点に畳み込む (folding)
+//     支配:      隣接する u, v について N[v] ⊆ N[u] なら u を除く
+//     双子:      隣接しない次数 3 の u, v について N(u) = N(v) で, N(u) の中に辺があれば u, v を採用する
+//     LP:        2 部二重被覆の最大マッチングから LP 緩和の半整数最適解を求め,
+//                値 1 の頂点を採用して値 0 の頂点を除く (Nemhauser-Trotter, crown reduction)
+//   上界: min(LP 緩和の値, 貪欲な clique cover の clique の個数)
+//   下界: 次数最小の頂点を採用し続ける貪欲法の解から始める
+//   非連結になったら連結成分ごとに解く (小さい成分から厳密に解き, 最大の成分だけ残りの下界で枝刈りする)
+//   分岐: 次数最大の頂点 v を採用する / v とその mirror を除く
+//     mirror: 距離 2 の頂点 u で N(v) \ N(u) が clique になるもの (v を除くなら u も除いてよい)
+//   採用と畳み込みの記録を逆順にたどって独立集合そのものを復元する
+//   自己ループのある頂点は独立集合に含めない
+
+// 並列化
+//   根で縮約した後の連結成分ごとに, 探索木を深さ SPLIT まで展開した各節点をタスクとし, タスクをスレッドに分けて解く
+//     タスクは根からの分岐の列で表し, 各スレッドは自分のグラフの複製で分岐をたどり直してから探索する
+//     各スレッドは自分の両端キューの先頭からタスクを取り, 空になったら他のスレッドのキューの末尾から盗む
+//   暫定解 (大きさ, タスク番号) を 1 つの atomic 変数で共有して, 他のスレッドの解でも枝刈りする
+//     大きさが同じなら番号の小さいタスクの解を優先し, 各タスクの中では DFS 順で最初の最適解を返すので,
+//     結果はスレッド数やスケジューリングに依らない
+//   小さな連結成分 (SMALL 頂点以下) と, 連結成分の中でさらに非連結になった部分は 1 スレッドで解く
+//   ※ threads > 1 のときは -pthread を付けてコンパイルする
+
+// 木幅の小さい連結成分
+//   SMALL 頂点より大きい連結成分は, MinFill で求めた木分解の幅が WIDTH 以下なら木分解上の DP で解く
+//   TreeDecomposition は TreeDecomposition.cpp と同じもの (頂点被覆は除く)
 
 // 解説: https://www.slideshare.net/wata_orz/ss-12131479
-// 実装: https://qiita.com/drken/items/7f98315b56c95a6181a4
+// 縮約: T. Akiba, Y. Iwata, "Branch-and-reduce exponential/FPT algorithms in practice", 2016
 
+#include<algorithm>
+#include<atomic>
+#include<bit>
+#include<cassert>
+#include<cstdint>
+#include<deque>
+#include<functional>
+#include<limits>
+#include<mutex>
+#include<queue>
+#include<thread>
+#include<utility>
 #include<vector>
 
 using Weight = long long;
@@ -13,59 +55,845 @@ using Vertex = int;
 struct Edge {Vertex from, to; Weight weight;};
 using Graph = std::vector<std::vector<Edge>>;
 
-int connected_case(const Graph&, std::vector<bool>& S);   // 頂点集合SによるGの誘導グラフに対して,
-int general_case(const Graph&, const std::vector<bool>&); //       最大独立集合のサイズを出力する.
+class TreeDecomposition {
+ public:
+  enum class Heuristic {MinDegree, MinFill};
+  enum Type {Leaf, Introduce, Forget, Join};
+  struct Node {Type type; Vertex v; int left, right;};   // Introduce, Forget は left だけ, Join は left と right を使う
+  static constexpr int MAX_BAG = 25;                      // DP できる bag の大きさの上限
+  TreeDecomposition(const Graph&, Heuristic = Heuristic::MinFill, int limit = std::numeric_limits<int>::max());
+  int width() const {return width_;}
+  const std::vector<Node>& nodes() const {return nice_;}
+  std::vector<Vertex> bag(int k) const {return {std::begin(bags_) + start_[k], std::begin(bags_) + start_[k + 1]};}
+  std::vector<Vertex> maximum_weight_independent_set(const std::vector<Weight>&) const;
+  std::vector<Vertex> maximum_independent_set() const {return maximum_weight_independent_set(std::vector<Weight>(n_, 1));}
+ private:
+  int n_, width_ = -1;
+  std::vector<std::vector<Vertex>> adj_;   // 昇順, 自己ループと多重辺は除く
+  std::vector<bool> loop_;
+  std::vector<Node> nice_;
+  std::vector<int> start_;                 // 節点 k の bag は bags_[start_[k]], ..., bags_[start_[k + 1] - 1]
+  std::vector<Vertex> bags_;
+  bool adjacent(Vertex u, Vertex v) const {return std::binary_search(std::begin(adj_[u]), std::end(adj_[u]), v);}
+  int add(Type type, Vertex v, int left, int right = -1);
+};
+
+// 昇順の A, B について A ∪ B から x, y を除いたもの
+static std::vector<Vertex> merge(const std::vector<Vertex>& A, const std::vector<Vertex>& B, Vertex x, Vertex y) {
+  std::vector<Vertex> result;
+  result.reserve(A.size() + B.size());
+  std::set_union(std::begin(A), std::end(A), std::begin(B), std::end(B), std::back_inserter(result));
+  result.erase(std::remove_if(std::begin(result), std::end(result), [&](Vertex u) {return u == x || u == y;}), std::end(result));
+  return result;
+}
+
+// bitmask の p bit 目を除く / p bit 目に b を挟む
+static std::uint32_t erase_bit(std::uint32_t m, int p) {return (m & ((1u << p) - 1)) | (m >> (p + 1) << p);}
+static std::uint32_t insert_bit(std::uint32_t m, int p, std::uint32_t b) {return (m & ((1u << p) - 1)) | b << p | (m >> p << (p + 1));}
+
+TreeDecomposition::TreeDecomposition(const Graph& G, Heuristic heuristic, int limit) : n_(G.size()), adj_(n_), loop_(n_) {
+  for(Vertex v = 0; v < n_; ++v) for(const auto& e: G[v]) {
+    if(e.to == v) loop_[v] = true;
+    else adj_[v].emplace_back(e.to), adj_[e.to].emplace_back(v);
+  }
+  for(auto& A: adj_) {
+    std::sort(std::begin(A), std::end(A));
+    A.erase(std::unique(std::begin(A), std::end(A)), std::end(A));
+  }
+
+  // 消去順序
+  auto H = adj_;                            // 消去途中のグラフ
+  std::vector<long long> fill(n_);
+  auto count = [&](Vertex v) {
+    if(limit < (int)H[v].size()) return -1ll;
+    long long c = 0;
+    for(std::size_t i = 0; i < H[v].size(); ++i) for(std::size_t j = i + 1; j < H[v].size(); ++j) {
+      if(!std::binary_search(std::begin(H[H[v][i]]), std::end(H[H[v][i]]), H[v][j])) ++c;
+    }
+    return c;
+  };
+  auto key = [&](Vertex v) {
+    if(heuristic == Heuristic::MinDegree) return (long long)H[v].size();
+    return fill[v] < 0 ? std::numeric_limits<long long>::max() : fill[v] * (n_ + 1) + (long long)H[v].size();
+  };
+  using Item = std::pair<long long, Vertex>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> q;
+  for(Vertex v = 0; v < n_; ++v) {
+    if(heuristic == Heuristic::MinFill) fill[v] = count(v);
+    q.emplace(key(v), v);
+  }
+  std::vector<Vertex> order;
+  std::vector<int> position(n_, -1);
+  std::vector<std::vector<Vertex>> neighbor(n_);   // 消去時の隣接頂点
+  while(!q.empty()) {
+    auto [k, v] = q.top();
+    q.pop();
+    if(position[v] != -1 || k != key(v)) continue;
+    if(limit < (int)H[v].size()) {
+      width_ = limit + 1;
+      return;
+    }
+    width_ = std::max(width_, (int)H[v].size());
+    position[v] = order.size();
+    order.emplace_back(v);
+    const auto& N = H[v];
+    bool simplicial = heuristic == Heuristic::MinFill && fill[v] == 0;
+    for(auto u: N) {
+      if(simplicial && 0 <= fill[u]) fill[u] -= H[u].size() - N.size();
+      H[u] = merge(H[u], N, u, v);
+      if(simplicial && fill[u] < 0) fill[u] = count(u);
+    }
+    if(heuristic == Heuristic::MinFill && !simplicial) {
+      std::vector<Vertex> touched(std::begin(N), std::end(N));
+      for(auto u: N) touched.insert(std::end(touched), std::begin(H[u]), std::end(H[u]));
+      std::sort(std::begin(touched), std::end(touched));
+      touched.erase(std::unique(std::begin(touched), std::end(touched)), std::end(touched));
+      for(auto u: touched) if(u != v && position[u] == -1) fill[u] = count(u), q.emplace(key(u), u);
+    } else {
+      for(auto u: N) q.emplace(key(u), u);
+    }
+    neighbor[v] = std::move(H[v]);
+    H[v].clear();
+  }
+  width_ = std::max(width_, 0);
+
+  // nice な木分解 (消去順に作ると子が親より前に並ぶ)
+  std::vector<std::vector<Vertex>> children(n_);
+  std::vector<Vertex> roots;
+  std::vector<int> top(n_);
+  start_ = {0};
+  for(auto v: order) {
+    std::vector<Vertex> B = neighbor[v];
+    B.insert(std::lower_bound(std::begin(B), std::end(B), v), v);
+    int cur = -1;
+    for(auto c: children[v]) {
+      auto k = top[c];
+      for(auto x: bag(k)) if(!std::binary_search(std::begin(B), std::end(B), x)) k = add(Forget, x, k);
+      auto C = bag(k);
+      for(auto x: B) if(!std::binary_search(std::begin(C), std::end(C), x)) k = add(Introduce, x, k);
+      cur = cur == -1 ? k : add(Join, -1, cur, k);
+    }
+    if(cur == -1) {
+      cur = add(Leaf, -1, -1);
+      for(auto x: B) cur = add(Introduce, x, cur);
+    }
+    top[v] = cur;
+    Vertex parent = -1;
+    for(auto u: neighbor[v]) if(parent == -1 || position[u] < position[parent]) parent = u;
+    if(parent == -1) roots.emplace_back(v);
+    else children[parent].emplace_back(v);
+  }
+  int root = -1;
+  for(auto r: roots) {
+    auto k = top[r];
+    for(auto x: bag(k)) k = add(Forget, x, k);
+    root = root == -1 ? k : add(Join, -1, root, k);
+  }
+  if(root == -1) add(Leaf, -1, -1);
+}
+
+// 節点を加えて番号を返す (bag は子の bag から作る)
+int TreeDecomposition::add(Type type, Vertex v, int left, int right) {
+  std::vector<Vertex> B;
+  if(type != Leaf) B = bag(left);
+  if(type == Introduce) B.insert(std::lower_bound(std::begin(B), std::end(B), v), v);
+  if(type == Forget) B.erase(std::lower_bound(std::begin(B), std::end(B), v));
+  nice_.push_back({type, v, left, right});
+  bags_.insert(std::end(bags_), std::begin(B), std::end(B));
+  start_.emplace_back(bags_.size());
+  return nice_.size() - 1;
+}
+
+std::vector<Vertex> TreeDecomposition::maximum_weight_independent_set(const std::vector<Weight>& weight) const {
+  assert(!nice_.empty() && width_ < MAX_BAG);
+  const Weight NEG = std::numeric_limits<Weight>::min() / 4;
+  const int K = nice_.size();
+  std::vector<std::vector<Weight>> table(K);
+  std::vector<std::vector<bool>> taken(K);   // Forget 節点で v を採用した方が大きかったか
+  std::vector<Weight> sum;
+  for(int k = 0; k < K; ++k) {
+    const auto& [type, v, left, right] = nice_[k];
+    auto B = std::begin(bags_) + start_[k];
+    int s = start_[k + 1] - start_[k];
+    auto& T = table[k];
+    T.assign(std::size_t(1) << s, NEG);
+    if(type == Leaf) {
+      T[0] = 0;
+    } else if(type == Introduce) {
+      int p = std::lower_bound(B, B + s, v) - B;
+      std::uint32_t conflict = 0;
+      for(int i = 0; i < s; ++i) if(i != p && adjacent(v, B[i])) conflict |= 1u << i;
+      const auto& C = table[left];
+      for(std::uint32_t m = 0; m < T.size(); ++m) {
+        auto value = C[erase_bit(m, p)];
+        if(!(m >> p & 1)) T[m] = value;
+        else if(!loop_[v] && !(m & conflict) && value != NEG) T[m] = value + weight[v];
+      }
+    } else if(type == Forget) {
+      auto D = std::begin(bags_) + start_[left];
+      int p = std::lower_bound(D, D + s + 1, v) - D;
+      const auto& C = table[left];
+      taken[k].assign(T.size(), false);
+      for(std::uint32_t m = 0; m < T.size(); ++m) {
+        auto a = C[insert_bit(m, p, 0)], b = C[insert_bit(m, p, 1)];
+        T[m] = std::max(a, b);
+        taken[k][m] = a < b;
+      }
+    } else {
+      sum.assign(T.size(), 0);
+      for(std::uint32_t m = 1; m < T.size(); ++m) sum[m] = sum[m & (m - 1)] + weight[B[std::countr_zero(m)]];
+      const auto &L = table[left], &R = table[right];
+      for(std::uint32_t m = 0; m < T.size(); ++m) if(L[m] != NEG && R[m] != NEG) T[m] = L[m] + R[m] - sum[m];
+    }
+    if(type != Leaf) std::vector<Weight>().swap(table[left]);
+    if(type == Join) std::vector<Weight>().swap(table[right]);
+  }
+
+  // 根から bitmask をたどって復元する
+  std::vector<std::uint32_t> mask(K);
+  std::vector<bool> in(n_);
+  for(int k = K - 1; 0 <= k; --k) {
+    const auto& [type, v, left, right] = nice_[k];
+    auto m = mask[k];
+    if(type == Introduce) {
+      auto B = std::begin(bags_) + start_[k];
+      int p = std::lower_bound(B, std::begin(bags_) + start_[k + 1], v) - B;
+      if(m >> p & 1) in[v] = true;
+      mask[left] = erase_bit(m, p);
+    } else if(type == Forget) {
+      auto D = std::begin(bags_) + start_[left];
+      int p = std::lower_bound(D, std::begin(bags_) + start_[left + 1], v) - D;
+      mask[left] = insert_bit(m, p, taken[k][m]);
+    } else if(type == Join) {
+      mask[left] = mask[right] = m;
+    }
+  }
+  std::vector<Vertex> result;
+  for(Vertex v = 0; v < n_; ++v) if(in[v]) result.emplace_back(v);
+  return result;
+}
+
+class IndependentSet {
+ public:
+  IndependentSet(const Graph&);
+  std::vector<Vertex> solve(int threads = 1);
+ private:
+  static constexpr int SPLIT = 8, SMALL = 64, WIDTH = 15;
+  using Bits = std::uint64_t;
+  using Path = std::vector<std::pair<bool, Vertex>>;   // 根からの分岐 (採用するか, 頂点)
+  enum Type {Remove, Merge};        // trail の種類
+  enum Decision {Take, Fold};       // 記録の種類
+  struct Trail {Type type; Vertex v; int start;};
+  struct Log {Decision type; Vertex v, u, w;};
+  int n, W;                         // 頂点数, 1 行の語数
+  std::vector<Bits> adj;            // 行 v は adj[v W], ..., adj[v W + W - 1] (畳み込みで変わる)
+  std::vector<Bits> alive;          // 残っている頂点
+  std::vector<int> deg;             // 残っている頂点の, 残っている頂点への次数
+  std::vector<Trail> trail;
+  std::vector<Vertex> added;        // 畳み込みで新たに隣接した頂点 (Merge の start 以降)
+  std::vector<Log> log;
+  int size = 0;                     // 採用した頂点数 + 畳み込みの回数
+  std::vector<Vertex> dirty;        // 縮約規則を調べ直す頂点
+  std::vector<bool> queued;
+  int lp_bound = 0;                 // 最後に計算した LP 緩和の値
+  const std::atomic<std::uint64_t>* shared = nullptr;  // 全スレッドの暫定解 (pack で表す)
+  std::uint32_t task = 0;           // 解いているタスクの番号
+  int origin = 0;                   // 連結成分を解き始めたときの size
+  int nested = 0;                   // 連結成分ごとの探索の入れ子の深さ
+  Bits* row(Vertex v) {return adj.data() + std::size_t(v) * W;}
+  bool test(const std::vector<Bits>& S, Vertex v) const {return S[v / 64] >> v % 64 & 1;}
+  bool adjacent(Vertex u, Vertex v) {return row(u)[v / 64] >> v % 64 & 1;}
+  template<class F> void each(const Bits* S, F f) const;
+  std::vector<Vertex> neighbors(Vertex v);
+  void touch(Vertex v);
+  void remove(Vertex v);
+  void take(Vertex v);
+  void fold(Vertex v);
+  void rollback(std::size_t);
+  bool rule(Vertex v);
+  bool crown();
+  void reduce();
+  int clique_cover();
+  std::vector<std::vector<Bits>> components() const;
+  std::vector<Vertex> mirrors(Vertex v);
+  std::vector<Vertex> restore(const std::vector<Log>&) const;
+  void clear();
+  Vertex pivot() const;
+  void exclude(Vertex v);
+  static std::uint64_t pack(int value, std::uint32_t task) {return std::uint64_t(value) << 32 | ~task;}
+  int floor(int lower, int base) const;
+  int search(int, std::vector<Log>&);
+  int greedy();
+  void split(int, Path&, std::vector<Path>&);
+  std::vector<Log> parallel(int threads);
+  bool decompose(std::vector<Log>&);
+};
+
+// S の各 bit の位置 v について f(v) を呼ぶ
+template<class F> void IndependentSet::each(const Bits* S, F f) const {
+  for(int i = 0; i < W; ++i) for(auto b = S[i]; b; b &= b - 1) f(i * 64 + std::countr_zero(b));
+}
+
+IndependentSet::IndependentSet(const Graph& G) : n(G.size()), W((n + 63) / 64), adj(std::size_t(n) * W), alive(W), deg(n), queued(n) {
+  std::vector<bool> loop(n);
+  for(Vertex v = 0; v < n; ++v) for(const auto& e: G[v]) {
+    if(e.from == e.to) loop[v] = true;
+    else row(e.from)[e.to / 64] |= Bits(1) << e.to % 64, row(e.to)[e.from / 64] |= Bits(1) << e.from % 64;
+  }
+  for(Vertex v = 0; v < n; ++v) alive[v / 64] |= Bits(1) << v % 64;
+  for(Vertex v = 0; v < n; ++v) for(int i = 0; i < W; ++i) deg[v] += std::popcount(row(v)[i]);
+  for(Vertex v = 0; v < n; ++v) if(loop[v]) remove(v);
+  trail.clear();
+  for(Vertex v = 0; v < n; ++v) if(test(alive, v)) touch(v);
+}
+
+std::vector<Vertex> IndependentSet::neighbors(Vertex v) {
+  std::vector<Vertex> result;
+  const auto* r = row(v);
+  for(int i = 0; i < W; ++i) for(auto b = r[i] & alive[i]; b; b &= b - 1) result.emplace_back(i * 64 + std::countr_zero(b));
+  return result;
+}
+
+void IndependentSet::touch(Vertex v) {
+  if(queued[v]) return;
+  queued[v] = true;
+  dirty.emplace_back(v);
+}
+
+void IndependentSet::remove(Vertex v) {
+  alive[v / 64] &= ~(Bits(1) << v % 64);
+  for(auto u: neighbors(v)) --deg[u], touch(u);
+  trail.push_back({Remove, v, 0});
+}
+
+void IndependentSet::take(Vertex v) {
+  log.push_back({Take, v, -1, -1});
+  ++size;
+  for(auto u: neighbors(v)) remove(u);
+  remove(v);
+}
+
+// 次数 2 の頂点 v と隣接しない隣接頂点 u, w を u 1 頂点にまとめる
+//   u を採用するなら元の u, w を, 採用しないなら v を採用する
+void IndependentSet::fold(Vertex v) {
+  auto N = neighbors(v);
+  auto u = N[0], w = N[1];
+  log.push_back({Fold, v, u, w});
+  ++size;
+  remove(v);
+  remove(w);
+  trail.push_back({Merge, u, int(added.size())});
+  auto *ru = row(u), *rw = row(w);
+  for(int i = 0; i < W; ++i) for(auto b = rw[i] & ~ru[i] & alive[i]; b; b &= b - 1) {
+    auto x = i * 64 + std::countr_zero(b);
+    added.emplace_back(x);
+    row(x)[u / 64] |= Bits(1) << u % 64;
+    ++deg[x];
+    ++deg[u];
+  }
+  for(auto i = trail.back().start; i < int(added.size()); ++i) ru[added[i] / 64] |= Bits(1) << added[i] % 64;
+  touch(u);
+  for(auto x: neighbors(u)) touch(x);
+}
+
+// trail を size まで巻き戻す
+void IndependentSet::rollback(std::size_t mark) {
+  while(mark < trail.size()) {
+    auto [type, v, start] = trail.back();
+    trail.pop_back();
+    if(type == Remove) {
+      for(auto u: neighbors(v)) ++deg[u];
+      alive[v / 64] |= Bits(1) << v % 64;
+    } else {
+      for(auto i = start; i < int(added.size()); ++i) {
+        auto x = added[i];
+        row(x)[v / 64] &= ~(Bits(1) << v % 64);
+        row(v)[x / 64] &= ~(Bits(1) << x % 64);
+        --deg[x];
+        --deg[v];
+      }
+      added.resize(start);
+    }
+  }
+}
+
+// 頂点 v に縮約規則を適用できれば適用して true を返す
+bool IndependentSet::rule(Vertex v) {
+  if(deg[v] <= 1) {
+    take(v);
+    return true;
+  }
+  auto N = neighbors(v);
+  if(deg[v] == 2) {
+    if(adjacent(N[0], N[1])) take(v);
+    else fold(v);
+    return true;
+  }
+  // 支配
+  const auto* rv = row(v);
+  for(auto u: N) if(deg[v] <= deg[u]) {
+    const auto* ru = row(u);
+    bool dominated = true;
+    for(int i = 0; i < W && dominated; ++i) {
+      auto rest = rv[i] & ~ru[i] & alive[i];
+      if(i == u / 64) rest &= ~(Bits(1) << u % 64);
+      dominated = rest == 0;
+    }
+    if(dominated) {
+      remove(u);
+      return true;
+    }
+  }
+  // 双子
+  if(deg[v] == 3 && (adjacent(N[0], N[1]) || adjacent(N[1], N[2]) || adjacent(N[2], N[0]))) {
+    for(auto u: neighbors(N[0])) if(u != v && deg[u] == 3) {
+      const auto* ru = row(u);
+      bool twin = true;
+      for(int i = 0; i < W && twin; ++i) twin = ((rv[i] ^ ru[i]) & alive[i]) == 0;
+      if(!twin) continue;
+      take(v);
+      take(u);
+      return true;
+    }
+  }
+  return false;
+}
+
+// LP 緩和による縮約 (変化があれば true を返す), lp_bound も更新する
+//   2 部二重被覆 (左右に頂点をコピーし, 辺 uv を左 u - 右 v, 左 v - 右 u とする) の最大マッチング M から
+//   König の定理で最小頂点被覆 C を求めると, y(v) = ([左 v ∈ C] + [右 v ∈ C]) / 2 が頂点被覆の LP 緩和の最適解になる
+//   最大独立集合の LP 緩和の値は |V| - |M| / 2
+bool IndependentSet::crown() {
+  std::vector<Vertex> vertex;
+  each(alive.data(), [&](Vertex v) {vertex.emplace_back(v);});
+  std::vector<Vertex> left(n, -1), right(n, -1);
+  std::vector<Bits> unvisited(W);
+  struct Frame {Vertex v; int i; Vertex y;};
+  std::vector<Frame> path;
+  int matched = 0;
+  // 増加のなかったパスで終了する (DenseBipartiteGraph と同じ)
+  for(bool augmented = true; augmented; ) {
+    augmented = false;
+    unvisited = alive;
+    for(auto root: vertex) if(left[root] == -1) {
+      path.assign(1, {root, 0, -1});
+      while(!path.empty()) {
+        auto& [v, i, y] = path.back();
+        const auto* r = row(v);
+        while(i < W && !(r[i] & unvisited[i])) ++i;
+        if(i == W) {
+          path.pop_back();
+          continue;
+        }
+        y = i * 64 + std::countr_zero(r[i] & unvisited[i]);
+        unvisited[i] &= ~(Bits(1) << y % 64);
+        if(right[y] != -1) {
+          path.push_back({right[y], 0, -1});
+          continue;
+        }
+        for(const auto& f: path) left[f.v] = f.y, right[f.y] = f.v;
+        ++matched;
+        augmented = true;
+        break;
+      }
+    }
+  }
+  lp_bound = int(vertex.size()) - (matched + 1) / 2;
+  // マッチしていない左の頂点から交互路で到達できる頂点 Z
+  std::vector<Bits> reach_left(W, 0), reach_right(W, 0);
+  std::vector<Vertex> q;
+  for(auto v: vertex) if(left[v] == -1) q.emplace_back(v), reach_left[v / 64] |= Bits(1) << v % 64;
+  unvisited = alive;
+  for(std::size_t head = 0; head < q.size(); ++head) {
+    const auto* r = row(q[head]);
+    for(int i = 0; i < W; ++i) for(auto b = r[i] & unvisited[i]; b; b &= b - 1) {
+      auto y = i * 64 + std::countr_zero(b);
+      unvisited[i] &= ~(Bits(1) << y % 64);
+      reach_right[i] |= Bits(1) << y % 64;
+      auto x = right[y];
+      if(x != -1 && !test(reach_left, x)) reach_left[x / 64] |= Bits(1) << x % 64, q.emplace_back(x);
+    }
+  }
+  // C = (左 \ Z) ∪ (右 ∩ Z), y(v) = 0 ⇔ 左 v ∈ Z, 右 v ∉ Z
+  std::vector<Vertex> in;
+  for(auto v: vertex) if(test(reach_left, v) && !test(reach_right, v)) in.emplace_back(v);
+  for(auto v: in) take(v);
+  return !in.empty();
+}
 
-void dfs(std::vector<bool>& used, std::vector<bool>& next, const Graph& G, const std::vector<bool>& target, Vertex v) {
-  used[v] = next[v] = true;
-  for(const auto& e: G[v]) if(!used[e.to] && target[e.to]) dfs(used, next, G, target, e.to);
+void IndependentSet::reduce() {
+  do {
+    while(!dirty.empty()) {
+      auto v = dirty.back();
+      dirty.pop_back();
+      queued[v] = false;
+      if(test(alive, v)) rule(v);
+    }
+  } while(crown());
 }
 
-int connected_case(const Graph& G, std::vector<bool>& target) {
-  int n = 0, mindeg = G.size(), maxdeg = 0, min = -1, max = -1;
-  for(Vertex v = 0; v < G.size(); ++v) if(target[v]) {
-    ++n;
-    auto deg = 0;
-    for(const auto& e: G[v]) if(target[e.to]) ++deg;
-    if(maxdeg < deg) maxdeg = deg, max = v;
-    if(deg < mindeg) mindeg = deg, min = v;
+// 貪欲な clique cover の clique の個数 (独立集合の大きさの上界)
+//   次数の小さい順に, すべての要素と隣接する最初の clique に入れる
+int IndependentSet::clique_cover() {
+  std::vector<Vertex> vertex;
+  each(alive.data(), [&](Vertex v) {vertex.emplace_back(v);});
+  std::sort(std::begin(vertex), std::end(vertex), [&](Vertex a, Vertex b) {return deg[a] < deg[b];});
+  std::vector<Bits> common;   // clique c のすべての要素と隣接する頂点は common[c W], ..., common[c W + W - 1]
+  int count = 0;
+  for(auto v: vertex) {
+    int c = 0;
+    while(c < count && !(common[std::size_t(c) * W + v / 64] >> v % 64 & 1)) ++c;
+    if(c == count) common.resize(std::size_t(++count) * W, ~Bits(0));
+    auto* C = common.data() + std::size_t(c) * W;
+    const auto* r = row(v);
+    for(int i = 0; i < W; ++i) C[i] &= r[i];
   }
-  // The vertex-induced subgraph is an isolated vertex
-  if(n == 1) return 1;
-  // The vertex-induced subgraph is a path or a cycle
-  if(maxdeg == 2) return mindeg==1 ? (n+1)/2 : n/2;
-  // Remove a leaf
-  if(mindeg == 1) {
-    auto next = target;
-    next[min] = false;
-    for(const auto& e: G[min]) next[e.to] = false;
-    return general_case(G, next) + 1;
+  return count;
+}
+
+// 残っている頂点の連結成分
+std::vector<std::vector<IndependentSet::Bits>> IndependentSet::components() const {
+  std::vector<std::vector<Bits>> result;
+  auto rest = alive;
+  std::vector<Vertex> q;
+  for(int i = 0; i < W; ++i) while(rest[i]) {
+    Vertex s = i * 64 + std::countr_zero(rest[i]);
+    std::vector<Bits> C(W, 0);
+    C[i] |= Bits(1) << s % 64;
+    rest[i] &= ~(Bits(1) << s % 64);
+    q.assign(1, s);
+    for(std::size_t head = 0; head < q.size(); ++head) {
+      const auto* r = adj.data() + std::size_t(q[head]) * W;
+      for(int j = 0; j < W; ++j) if(auto b = r[j] & rest[j]) {
+        C[j] |= b;
+        rest[j] &= ~b;
+        for(; b; b &= b - 1) q.emplace_back(j * 64 + std::countr_zero(b));
+      }
+    }
+    result.emplace_back(std::move(C));
   }
-  // Remove a maxmum-degree vertex
-  auto next = target;
-  next[max] = false;
-  auto res = general_case(G, next);
-  for(const auto& e: G[max]) next[e.to] = false;
-  return std::max(res, general_case(G, next) + 1);
+  return result;
 }
 
-int general_case(const Graph& G, const std::vector<bool>& target) {
-  std::vector<bool> used(G.size());
-  int res = 0;
-  for(Vertex v = 0; v < G.size(); ++v) if(!used[v]) {
-    std::vector<bool> next(G.size());
-    dfs(used, next, G, target, v);
-    res += connected_case(G, next);
+// 頂点 v の mirror (距離 2 の頂点 u で, N(v) \ N(u) が clique になるもの)
+std::vector<Vertex> IndependentSet::mirrors(Vertex v) {
+  const auto* rv = row(v);
+  std::vector<Bits> second(W, 0), D(W);
+  for(auto x: neighbors(v)) for(int i = 0; i < W; ++i) second[i] |= row(x)[i];
+  for(int i = 0; i < W; ++i) second[i] &= alive[i] & ~rv[i];
+  second[v / 64] &= ~(Bits(1) << v % 64);
+  std::vector<Vertex> result;
+  each(second.data(), [&](Vertex u) {
+    const auto* ru = row(u);
+    for(int i = 0; i < W; ++i) D[i] = rv[i] & ~ru[i] & alive[i];
+    bool clique = true;
+    each(D.data(), [&](Vertex x) {
+      const auto* rx = row(x);
+      for(int i = 0; i < W && clique; ++i) clique = (D[i] & ~rx[i] & ~(i == x / 64 ? Bits(1) << x % 64 : 0)) == 0;
+    });
+    if(clique) result.emplace_back(u);
+  });
+  return result;
+}
+
+// 記録を逆順にたどって元のグラフの独立集合を復元する
+std::vector<Vertex> IndependentSet::restore(const std::vector<Log>& log) const {
+  std::vector<bool> in(n);
+  for(auto i = log.rbegin(); i != log.rend(); ++i) {
+    if(i->type == Take) in[i->v] = true;
+    else if(in[i->u]) in[i->w] = true;
+    else in[i->v] = true;
   }
-  return res;
+  std::vector<Vertex> result;
+  for(Vertex v = 0; v < n; ++v) if(in[v]) result.emplace_back(v);
+  return result;
+}
+
+void IndependentSet::clear() {
+  for(auto u: dirty) queued[u] = false;
+  dirty.clear();
+}
+
+// 分岐する頂点 (次数最大)
+Vertex IndependentSet::pivot() const {
+  Vertex v = -1;
+  each(alive.data(), [&](Vertex u) {if(v == -1 || deg[v] < deg[u]) v = u;});
+  return v;
+}
+
+// v とその mirror を除く
+void IndependentSet::exclude(Vertex v) {
+  for(auto u: mirrors(v)) remove(u);
+  remove(v);
 }
 
-int maximum_independent_set(const Graph& G) {
-  return general_case(G, std::vector<bool>(G.size()));
+// 共有している暫定解で lower を引き上げる (base は節点での size)
+//   番号の大きいタスクや貪欲法の解と同じ大きさの解は探し, 番号の小さいタスクの解と同じ大きさの解は探さない
+//   連結成分ごとの探索の中では大きさを比べられないので使わない
+int IndependentSet::floor(int lower, int base) const {
+  if(!shared || nested) return lower;
+  auto key = shared->load(std::memory_order_relaxed);
+  int best = key >> 32;
+  std::uint32_t owner = ~std::uint32_t(key);
+  return std::max(lower, (owner < task ? best : best - 1) - (base - origin));
+}
+
+// 残っているグラフで lower より大きな独立集合を探し, 見つかれば最大のものの大きさを返して out にその記録を入れる
+//   見つからなければ lower を返す (out は変えない)
+//   大きさは呼び出し時点からの増分 (採用した頂点数 + 畳み込みの回数) で数える
+int IndependentSet::search(int lower, std::vector<Log>& out) {
+  auto mark = trail.size();
+  auto log_mark = log.size();
+  auto size_mark = size;
+  reduce();
+  auto result = lower;
+  auto gain = [&]() {return size - size_mark;};
+  auto record = [&](int value, const std::vector<Log>& sub) {
+    if(value <= result) return;
+    result = value;
+    out.assign(std::begin(log) + log_mark, std::end(log));
+    out.insert(std::end(out), std::begin(sub), std::end(sub));
+  };
+  std::vector<Log> sub;
+  if(std::none_of(std::begin(alive), std::end(alive), [](Bits b) {return b;})) {
+    record(gain(), sub);
+  } else if(auto bound = floor(result, size_mark); bound < gain() + lp_bound && bound < gain() + clique_cover()) {
+    auto C = components();
+    if(1 < C.size()) {
+      auto count = [](const std::vector<Bits>& S) {
+        int c = 0;
+        for(auto b: S) c += std::popcount(b);
+        return c;
+      };
+      std::sort(std::begin(C), std::end(C), [&](const auto& a, const auto& b) {return count(a) < count(b);});
+      auto saved = alive;
+      auto total = gain();
+      std::vector<Log> all;
+      bool complete = true;
+      ++nested;
+      for(std::size_t k = 0; k < C.size() && complete; ++k) {
+        auto pass = k + 1 < C.size() ? -1 : bound - total;
+        alive = C[k];
+        auto r = search(pass, sub);
+        alive = saved;
+        complete = pass < r;
+        total += r;
+        all.insert(std::end(all), std::begin(sub), std::end(sub));
+      }
+      --nested;
+      if(complete) record(total, all);
+    } else {
+      auto v = pivot();
+      auto inner = trail.size();
+      auto inner_log = log.size();
+      auto inner_size = size;
+      exclude(v);
+      auto pass = floor(result, size_mark) - gain();
+      auto r = search(pass, sub);
+      if(pass < r) record(gain() + r, sub);
+      rollback(inner);
+      log.resize(inner_log);
+      size = inner_size;
+      clear();
+      take(v);
+      pass = floor(result, size_mark) - gain();
+      r = search(pass, sub);
+      if(pass < r) record(gain() + r, sub);
+    }
+  }
+  rollback(mark);
+  log.resize(log_mark);
+  size = size_mark;
+  clear();
+  return result;
+}
+
+// 次数最小の頂点を採用し続ける貪欲法の解の大きさ (グラフは元に戻す)
+int IndependentSet::greedy() {
+  auto mark = trail.size();
+  auto log_mark = log.size();
+  auto size_mark = size;
+  for(Vertex v; (v = -1, each(alive.data(), [&](Vertex u) {if(v == -1 || deg[u] < deg[v]) v = u;}), v != -1); ) take(v);
+  auto result = size - size_mark;
+  rollback(mark);
+  log.resize(log_mark);
+  size = size_mark;
+  clear();
+  return result;
+}
+
+// 探索木を深さ depth まで展開し, 各節点への分岐の列を tasks に入れる (search と同じ順に縮約と分岐を行う)
+void IndependentSet::split(int depth, Path& path, std::vector<Path>& tasks) {
+  auto mark = trail.size();
+  auto log_mark = log.size();
+  auto size_mark = size;
+  reduce();
+  auto v = pivot();
+  if(v == -1 || depth == 0 || 1 < components().size()) {
+    tasks.emplace_back(path);
+  } else {
+    for(bool adopt: {false, true}) {
+      auto inner = trail.size();
+      auto inner_log = log.size();
+      auto inner_size = size;
+      if(adopt) take(v);
+      else exclude(v);
+      path.emplace_back(adopt, v);
+      split(depth - 1, path, tasks);
+      path.pop_back();
+      rollback(inner);
+      log.resize(inner_log);
+      size = inner_size;
+      clear();
+    }
+  }
+  rollback(mark);
+  log.resize(log_mark);
+  size = size_mark;
+  clear();
+}
+
+// 残っている (連結な) グラフの最大独立集合をタスクに分けて並列に求め, 記録を返す
+std::vector<IndependentSet::Log> IndependentSet::parallel(int threads) {
+  std::vector<Path> tasks;
+  Path path;
+  split(SPLIT, path, tasks);
+  const int T = tasks.size();
+  threads = std::max(1, std::min(threads, T));
+  std::atomic<std::uint64_t> key(pack(greedy(), ~std::uint32_t(0)));
+  std::mutex mutex;
+  std::vector<Log> best;
+  std::vector<std::deque<int>> queue(threads);
+  std::vector<std::mutex> lock(threads);
+  for(int t = 0; t < T; ++t) queue[t % threads].emplace_back(t);
+  auto pop = [&](int k) {
+    for(int d = 0; d < threads; ++d) {
+      auto o = (k + d) % threads;
+      std::lock_guard<std::mutex> guard(lock[o]);
+      if(queue[o].empty()) continue;
+      int t = d == 0 ? queue[o].front() : queue[o].back();
+      if(d == 0) queue[o].pop_front();
+      else queue[o].pop_back();
+      return t;
+    }
+    return -1;
+  };
+  auto run = [&](int k) {
+    auto solver = *this;
+    solver.shared = &key;
+    solver.origin = size;
+    auto mark = trail.size();
+    auto log_mark = log.size();
+    for(int t; (t = pop(k)) != -1; ) {
+      solver.task = t;
+      for(auto [adopt, v]: tasks[t]) {
+        solver.reduce();
+        if(adopt) solver.take(v);
+        else solver.exclude(v);
+      }
+      std::vector<Log> out;
+      auto pass = solver.floor(-1, solver.size);
+      auto r = solver.search(pass, out);
+      if(pass < r) {
+        auto value = pack(solver.size - size + r, t);
+        std::lock_guard<std::mutex> guard(mutex);
+        if(key.load() < value) {
+          key.store(value);
+          best.assign(std::begin(solver.log) + log_mark, std::end(solver.log));
+          best.insert(std::end(best), std::begin(out), std::end(out));
+        }
+      }
+      solver.rollback(mark);
+      solver.log.resize(log_mark);
+      solver.size = size;
+      solver.clear();
+    }
+  };
+  if(threads == 1) {
+    run(0);
+  } else {
+    std::vector<std::thread> pool;
+    for(int k = 0; k < threads; ++k) pool.emplace_back(run, k);
+    for(auto& t: pool) t.join();
+  }
+  return best;
+}
+
+// 残っているグラフの木分解の幅が WIDTH 以下なら, 木分解上の DP で最大独立集合を求めて記録に加える
+bool IndependentSet::decompose(std::vector<Log>& out) {
+  std::vector<Vertex> id, local(n, -1);
+  each(alive.data(), [&](Vertex v) {local[v] = id.size(); id.emplace_back(v);});
+  Graph H(id.size());
+  for(std::size_t i = 0; i < id.size(); ++i) {
+    auto v = id[i];
+    for(int k = 0; k < W; ++k) {
+      for(auto b = row(v)[k] & alive[k]; b; b &= b - 1) {
+        Vertex u = k * 64 + std::countr_zero(b);
+        if(v < u) H[i].push_back({Vertex(i), local[u], 1});
+      }
+    }
+  }
+  TreeDecomposition td(H, TreeDecomposition::Heuristic::MinFill, WIDTH);
+  if(WIDTH < td.width()) return false;
+  for(auto i: td.maximum_independent_set()) out.push_back({Take, id[i], -1, -1});
+  return true;
+}
+
+std::vector<Vertex> IndependentSet::solve(int threads) {
+  reduce();
+  auto all = log;
+  auto saved = alive;
+  for(const auto& C: components()) {
+    alive = C;
+    std::vector<Log> out;
+    int count = 0;
+    for(auto b: C) count += std::popcount(b);
+    if(count <= SMALL) search(-1, out);
+    else if(!decompose(out)) out = parallel(threads);
+    all.insert(std::end(all), std::begin(out), std::end(out));
+  }
+  alive = saved;
+  return restore(all);
+}
+
+std::vector<Vertex> maximum_independent_set(const Graph& G, int threads = 1) {
+  return IndependentSet(G).solve(threads);
 }
 
 #include<bits/stdc++.h>
 using namespace std;
 
 int main() {
+  /*
+  // ベンチマーク (1 コア, 辺は確率 p で独立に張る)
+  //   n = 150, p = 0.05: 大きさ 56, threads = 1 で 80ms,   threads = 4 で 100ms
+  //   n = 180, p = 0.05: 大きさ 60, threads = 1 で 1830ms, threads = 4 で 2240ms
+  //   ※ 1 コアでは threads を増やしても速くならない (結果の集合は threads に依らず同じ)
+  auto bench = [](int n, double p, int threads) {
+    mt19937 rng(1);
+    Graph G(n);
+    for(Vertex u = 0; u < n; ++u) for(Vertex v = u + 1; v < n; ++v) if(rng() % 100000 < p * 100000) {
+      G[u].push_back({u, v, 1});
+      G[v].push_back({v, u, 1});
+    }
+    auto start = chrono::steady_clock::now();
+    auto S = maximum_independent_set(G, threads);
+    auto end = chrono::steady_clock::now();
+    cout << n << " " << threads << ": " << S.size() << " " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+  };
+  for(int threads: {1, 4}) bench(150, 0.05, threads), bench(180, 0.05, threads);
+  */
+
+  // 5 頂点の閉路と, その 1 頂点につながる 3 頂点の道
+  Graph G(8);
+  auto insert = [&](Vertex u, Vertex v) {
+    G[u].push_back({u, v, 1});
+    G[v].push_back({v, u, 1});
+  };
+  for(Vertex v = 0; v < 5; ++v) insert(v, (v + 1) % 5);
+  insert(0, 5); insert(5, 6); insert(6, 7);
+  auto S = maximum_independent_set(G, 2);
+  cout << S.size() << ":";
+  for(auto v: S) cout << " " << v;
+  cout << endl;
 }
@@ -0,0 +1,235 @@
+// 隣接リストで表現された無向グラフの大域最小カット
+
+// 辺は両方向に追加しておくこと (Graph.cpp と同じ表現)
+// 戻り値は (カットの値, カットの片側の頂点集合)
+//   頂点数が 2 未満の場合はカットが存在しないので (numeric_limits<Weight>::max(), {}) を返す
+
+// Stoer-Wagner: 決定的 O(|V| |E| log |E|)
+//   解説: https://en.wikipedia.org/wiki/Stoer%E2%80%93Wagner_algorithm
+//   最大隣接順序で頂点を並べると, 最後の 2 頂点 s, t について「t だけ」のカットが s-t 最小カットになる
+//   s と t を縮約して繰り返し, 各段階のカットの最小値を答えとする
+//   最大隣接順序は遅延削除付きの二分ヒープで求め, 縮約は小さい方の隣接リストを大きい方へ移す
+
+// Karger-Stein: 乱択 O(|V|^2 log^3 |V|) (1 回の試行 O(|V|^2 log |V|) を log^2 |V| 回), メモリ O(|V|^2)
+//   失敗確率は試行回数に対して指数的に小さい
+//   解説: https://en.wikipedia.org/wiki/Karger%27s_algorithm
+//   重みに比例した確率で辺を選んで縮約し, 頂点数を |V| / sqrt(2) + 1 まで減らすことを 2 回独立に行って再帰する
+//   縮約は UnionFindLight ではなく隣接行列で行う: 多重辺が 1 つの重みにまとまり, 頂点数 k の段は O(k^2)
+//     (辺のリストを UnionFindLight で縮約すると, 多重辺が減らないので各段に |E| かかる)
+//     重み付き次数に比例して u を, u からの辺の重みに比例して v を選ぶと, 辺を重みに比例して選んだことになる
+//   試行はスレッドに分けて並列に行う; 試行ごとに seed + 試行番号で乱数を初期化するので, 結果はスレッド数に依らない
+//   ※ threads > 1 のときは -pthread を付けてコンパイルする
+
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<numeric>
+#include<queue>
+#include<random>
+#include<thread>
+#include<utility>
+#include<vector>
+
+using Weight = long long;
+using Vertex = int;
+struct Edge {Vertex from, to; Weight weight;};
+using Graph = std::vector<std::vector<Edge>>;
+
+// 省メモリ, 要素数でマージ (x が根 ⇒ p_[x] = -(要素数))
+class UnionFindLight {
+ public:
+  UnionFindLight(int n) : p_(n, -1) {}
+  void unite(int a, int b) {
+    auto x = find(a), y = find(b);
+    if(x == y) return;
+    if(-p_[x] < -p_[y]) std::swap(x, y);
+    p_[x] += p_[y];
+    p_[y] = x;
+  }
+  int find(int x) {return p_[x] < 0 ? x : p_[x] = find(p_[x]);}
+  int size(int x) {return -p_[find(x)];}
+ private:
+  std::vector<int> p_;
+};
+
+std::pair<Weight, std::vector<Vertex>> StoerWagner(const Graph& G) {
+  const int n = G.size();
+  if(n < 2) return {std::numeric_limits<Weight>::max(), {}};
+  std::vector<std::vector<std::pair<Vertex, Weight>>> adj(n);   // 縮約後の隣接リスト (相手は縮約前の頂点番号のこともある)
+  std::vector<std::vector<Vertex>> member(n);                   // 縮約された頂点に含まれる元の頂点
+  UnionFindLight uf(n);
+  for(Vertex v = 0; v < n; ++v) {
+    member[v] = {v};
+    for(const auto& e: G[v]) if(e.to != v) adj[v].emplace_back(e.to, e.weight);
+  }
+  std::vector<Vertex> alive(n);
+  for(Vertex v = 0; v < n; ++v) alive[v] = v;
+  std::vector<Weight> key(n);
+  std::vector<bool> added(n);
+  Weight best = std::numeric_limits<Weight>::max();
+  std::vector<Vertex> side;
+  while(1 < alive.size()) {
+    // 最大隣接順序
+    using Node = std::pair<Weight, Vertex>;
+    std::priority_queue<Node> q;
+    for(auto v: alive) key[v] = 0, added[v] = false, q.emplace(0, v);
+    Vertex s = -1, t = -1;
+    while(!q.empty()) {
+      auto [k, v] = q.top();
+      q.pop();
+      if(added[v] || k != key[v]) continue;
+      added[v] = true;
+      s = t;
+      t = v;
+      for(const auto& [x, w]: adj[v]) {
+        auto y = uf.find(x);
+        if(added[y]) continue;
+        key[y] += w;
+        q.emplace(key[y], y);
+      }
+    }
+    if(key[t] < best) best = key[t], side = member[t];
+    // s と t を縮約
+    uf.unite(s, t);
+    auto r = uf.find(s), o = r == s ? t : s;
+    if(adj[r].size() < adj[o].size()) std::swap(adj[r], adj[o]);
+    adj[r].insert(std::end(adj[r]), std::begin(adj[o]), std::end(adj[o]));
+    std::vector<std::pair<Vertex, Weight>>().swap(adj[o]);
+    if(member[r].size() < member[o].size()) std::swap(member[r], member[o]);
+    member[r].insert(std::end(member[r]), std::begin(member[o]), std::end(member[o]));
+    std::vector<Vertex>().swap(member[o]);
+    // 縮約で生じた自己ループを取り除く
+    adj[r].erase(std::remove_if(std::begin(adj[r]), std::end(adj[r]), [&](const auto& p) {return uf.find(p.first) == r;}), std::end(adj[r]));
+    alive.erase(std::find(std::begin(alive), std::end(alive), o));
+  }
+  std::sort(std::begin(side), std::end(side));
+  return {best, side};
+}
+
+std::pair<Weight, std::vector<Vertex>> KargerStein(const Graph& G, int trials = 0, int threads = 1, unsigned seed = 0) {
+  const int n = G.size();
+  if(n < 2) return {std::numeric_limits<Weight>::max(), {}};
+  // 隣接行列 (対角は 0)
+  using Matrix = std::vector<Weight>;
+  Matrix W(std::size_t(n) * n, 0);
+  for(const auto& E: G) for(const auto& e: E) if(e.from != e.to && 0 < e.weight) W[std::size_t(e.from) * n + e.to] += e.weight;
+  // 頂点数 n のグラフ W を頂点数 k まで縮約し, 縮約後の頂点番号 id とグラフを返す O(n^2)
+  //   辺が尽きた (非連結な) ときは k より多い頂点で止まる
+  auto contract = [](int n, Matrix W, int k, std::mt19937_64& rng, std::vector<Vertex>& id) {
+    std::vector<Weight> degree(n, 0);
+    for(int u = 0; u < n; ++u) for(int v = 0; v < n; ++v) degree[u] += W[std::size_t(u) * n + v];
+    Weight total = 0;
+    for(auto d: degree) total += d;
+    std::vector<Vertex> alive(n), into(n);
+    std::iota(std::begin(alive), std::end(alive), 0);
+    std::iota(std::begin(into), std::end(into), 0);
+    int rest = n;
+    while(k < rest && 0 < total) {
+      auto r = std::uniform_int_distribution<Weight>(0, total - 1)(rng);
+      int i = 0;
+      while(degree[alive[i]] <= r) r -= degree[alive[i++]];
+      auto u = alive[i];
+      r = std::uniform_int_distribution<Weight>(0, degree[u] - 1)(rng);
+      int j = 0;
+      while(W[std::size_t(u) * n + alive[j]] <= r) r -= W[std::size_t(u) * n + alive[j++]];
+      auto v = alive[j];
+      // v を u へまとめる
+      for(int x = 0; x < rest; ++x) {
+        auto y = alive[x];
+        if(y == u || y == v) continue;
+        W[std::size_t(y) * n + u] = W[std::size_t(u) * n + y] += W[std::size_t(v) * n + y];
+      }
+      degree[u] += degree[v] - 2 * W[std::size_t(u) * n + v];
+      total -= 2 * W[std::size_t(u) * n + v];
+      W[std::size_t(u) * n + v] = W[std::size_t(v) * n + u] = 0;
+      into[v] = u;
+      alive[j] = alive[--rest];
+    }
+    std::vector<Vertex> index(n, -1);
+    for(int a = 0; a < rest; ++a) index[alive[a]] = a;
+    id.assign(n, -1);
+    for(Vertex v = 0; v < n; ++v) {
+      auto x = v;
+      while(index[x] == -1) x = into[x];
+      id[v] = index[x];
+    }
+    Matrix F(std::size_t(rest) * rest);
+    for(int a = 0; a < rest; ++a) for(int b = 0; b < rest; ++b) F[std::size_t(a) * rest + b] = W[std::size_t(alive[a]) * n + alive[b]];
+    return std::make_pair(rest, F);
+  };
+  // 頂点数 n のグラフ W の最小カットを乱択で求める; side[v] はカットの片側に含まれるか
+  auto recurse = [&](auto& recurse, int n, const Matrix& W, std::mt19937_64& rng, std::vector<bool>& side) -> Weight {
+    if(n <= 6) {
+      // 全探索
+      Weight best = std::numeric_limits<Weight>::max();
+      for(int S = 1; S < (1 << (n - 1)); ++S) {
+        Weight cut = 0;
+        for(int u = 0; u < n; ++u) for(int v = u + 1; v < n; ++v) if((S >> u & 1) != (S >> v & 1)) cut += W[std::size_t(u) * n + v];
+        if(best <= cut) continue;
+        best = cut;
+        side.assign(n, false);
+        for(Vertex v = 0; v < n; ++v) side[v] = S >> v & 1;
+      }
+      return best;
+    }
+    auto k = int(std::ceil(1 + n / std::sqrt(2.0)));
+    Weight best = std::numeric_limits<Weight>::max();
+    for(int repeat = 0; repeat < 2; ++repeat) {
+      std::vector<Vertex> id;
+      std::vector<bool> sub;
+      auto [m, F] = contract(n, W, k, rng, id);
+      // k 頂点まで縮約できなかった場合は非連結で, 縮約後の各頂点に辺が残っていない
+      auto cut = k < m ? Weight(0) : recurse(recurse, m, F, rng, sub);
+      if(k < m) {
+        sub.assign(m, false);
+        sub[id[0]] = true;
+      }
+      if(best <= cut) continue;
+      best = cut;
+      side.assign(n, false);
+      for(Vertex v = 0; v < n; ++v) side[v] = sub[id[v]];
+    }
+    return best;
+  };
+  if(trials <= 0) trials = std::max(1, int(std::ceil(std::pow(std::log2(n), 2))));
+  threads = std::max(1, std::min(threads, trials));
+  std::vector<Weight> value(trials);
+  std::vector<std::vector<bool>> side(trials);
+  auto run = [&](int first) {
+    for(auto i = first; i < trials; i += threads) {
+      std::mt19937_64 rng(seed + i);
+      value[i] = recurse(recurse, n, W, rng, side[i]);
+    }
+  };
+  if(threads == 1) {
+    run(0);
+  } else {
+    std::vector<std::thread> pool;
+    for(int k = 0; k < threads; ++k) pool.emplace_back(run, k);
+    for(auto& t: pool) t.join();
+  }
+  auto i = std::min_element(std::begin(value), std::end(value)) - std::begin(value);
+  std::vector<Vertex> result;
+  for(Vertex v = 0; v < n; ++v) if(side[i][v]) result.emplace_back(v);
+  return {value[i], result};
+}
+
+#include<bits/stdc++.h>
+using namespace std;
+
+int main() {
+  // 2 つの三角形を重み 1 の辺でつないだグラフ
+  Graph G(6);
+  auto insert = [&](Vertex u, Vertex v, Weight w) {
+    G[u].push_back({u, v, w});
+    G[v].push_back({v, u, w});
+  };
+  insert(0, 1, 3); insert(1, 2, 3); insert(2, 0, 3);
+  insert(3, 4, 3); insert(4, 5, 3); insert(5, 3, 3);
+  insert(2, 3, 1);
+  for(auto [cut, side]: {StoerWagner(G), KargerStein(G, 0, 4)}) {
+    cout << cut << ":";
+    for(auto v: side) cout << " " << v;
+    cout << endl;
+  }
+}
@@ -0,0 +1,645 @@
+// 無向グラフの平面性判定
+
+// 辺は両方向に追加しておくこと (Graph.cpp と同じ表現), 自己ループと多重辺は平面性に関係しないので無視する
+// planarity(G)  平面的なら O(|V| + |E|)
+//               平面的でないときの Kuratowski 部分グラフの抽出は O(|V| + |E|) + 衝突の根拠の大きさに依存する部分 (下記)
+//   planar      平面的か
+//   rotation    平面的なとき, 平面埋め込みの回転系 (rotation[v] は v に隣接する頂点を反時計回りに並べたもの)
+//               PlaneGraph::build(rotation) にそのまま渡せる
+//   kuratowski  平面的でないとき, K5 か K3,3 の細分になっている G の部分グラフの辺
+//               (次数 3 の頂点が 6 個なら K3,3, 次数 4 の頂点が 5 個なら K5)
+
+// Left-Right 平面性判定 (de Fraysseix-Rosenstiehl)
+//   参考: U. Brandes, The Left-Right Planarity Test (2009)
+//   Boyer-Myrvold と同じく O(n) で, DFS 3 回と衝突対 (conflict pair) のスタックだけで書ける
+//   (1) DFS で辺を向き付け, 各辺の lowpt, lowpt2 から nesting depth を求める
+//   (2) 各頂点から出る辺を nesting depth の順に DFS し, 戻り辺を DFS 木の左右どちらに置くかの制約を衝突対のスタックで管理する
+//       左右どちらにも置けない戻り辺があれば平面的でない
+//   (3) ref をたどって各辺の左右を確定させ, 左右で符号を付けた nesting depth の順に回転系を作る
+//   辺数が 3|V| - 6 より多ければ先頭の 3|V| - 5 本だけを判定する; DFS は再帰せず, ソートは計数ソートで行う
+// Kuratowski 部分グラフ: 判定が止まったときの衝突から候補を取り出し, それを平面性判定をくり返して減らす
+//   (a) 衝突対を作るたびに, その根拠 (lowpt が決め手になった 2 辺と, まとめた衝突対の根拠) を森として残しておく
+//       判定が止まったら, 止まった衝突対の根拠をたどって戻り辺を集め, DFS 木の辺と合わせて witness とする
+//       左右の制約は DFS 木と根拠の戻り辺だけで決まるので, witness も平面的でない (O(|V| + |E|))
+//   (b) witness から始め, 残っている辺は常に平面的でないようにし, 除くと平面的になるとわかった辺を必要な辺 R とする
+//       (1) 次数 1 の頂点につながる辺を除き, 次数 2 の頂点を通る道を 1 本の辺にまとめる (どちらかが R なら R に入れる)
+//           DFS 木の枝はここで消え, 残る道の数は根拠の戻り辺の数 r の定数倍になる
+//       (2) R 以外の道から乱数で chunk 本選び, 除いても平面的でなければ除いて chunk を 2 倍にする
+//           平面的になるなら chunk を半分にし, chunk = 1 ならその道を R に入れる
+//           平面的でないときは, 残っている道をその判定の witness と R に絞る
+//       (3) R 以外の道がなくなるまでくり返す; R のどの道を除いても平面的になるので, R は極小な非平面部分グラフ (= K5 か K3,3 の細分)
+//   (c) 道は DFS 木に沿っていて長いので, 9 本か 10 本の道を 1 本ずつ, 他の道を通らない BFS の最短路に付け替える
+//   (b) の判定は道 O(r) 本のグラフに対して最悪 O(r log r) 回なので, 抽出全体は O(|V| + |E| + r^2 log r)
+//   r は多くの場合小さいが, 最悪 O(|E|) になりうる (witness が平面的なら念のため全辺から始める)
+
+#include<algorithm>
+#include<cassert>
+#include<random>
+#include<utility>
+#include<vector>
+
+using Weight = long long;
+using Vertex = int;
+struct Edge {Vertex from, to; Weight weight;};
+using Graph = std::vector<std::vector<Edge>>;
+
+class LeftRight {
+ public:
+  // 頂点数 n の単純グラフ edges が平面的か (embed なら rotation に埋め込みを入れる)
+  bool operator()(int n, const std::vector<std::pair<Vertex, Vertex>>& edges, bool embed);
+  std::vector<std::vector<Vertex>> rotation;
+  // 平面的でないとき, DFS 木の辺と, 判定が止まった衝突の根拠になった辺の番号 (この辺集合も平面的でない)
+  std::vector<int> witness;
+ private:
+  struct Interval {
+    int low = -1, high = -1;
+    bool empty() const {return low == -1 && high == -1;}
+  };
+  struct ConflictPair {Interval L, R; int reason = -1;};
+  // 衝突対ができた根拠: 辺 a, b と, この衝突対にまとめられた衝突対の根拠 (child から sibling をたどる)
+  struct Reason {int a, b, child, sibling;};
+  // 向き付けた辺 source → target (同じ辺の値はまとめて参照するので 1 つの構造体に入れる)
+  struct Arc {int source, target, lowpt, lowpt2, nesting, ref, side, bottom, lowpt_edge;};
+  std::vector<int> height_, parent_, pos_, start_, out_, roots_, stack_, vertex_, edge_;
+  std::vector<Arc> arc_;
+  std::vector<ConflictPair> S_;
+  std::vector<Reason> reason_;
+  int failed_ = -1;
+  int make_reason(int a, int b) {
+    reason_.push_back({a, b, -1, -1});
+    return reason_.size() - 1;
+  }
+  void merge_reason(int r, int child) {
+    reason_[child].sibling = reason_[r].child;
+    reason_[r].child = child;
+  }
+  bool conflicting(const Interval& I, int b) const {return !I.empty() && arc_[I.high].lowpt > arc_[b].lowpt;}
+  int lowest(const ConflictPair& P) const {
+    if(P.L.empty()) return arc_[P.R.low].lowpt;
+    if(P.R.empty()) return arc_[P.L.low].lowpt;
+    return std::min(arc_[P.L.low].lowpt, arc_[P.R.low].lowpt);
+  }
+  void relabel(int n, const std::vector<int>& pre);
+  void order(int n);
+  bool add_constraints(int ei, int e);
+  void remove_back_edges(int e);
+  int sign(int e);
+  bool fail();
+};
+
+// 頂点を DFS の行きがけ順 pre に付け直し, 辺を (始点, nesting) の順に並べ直す (計数ソート)
+//   頂点 v から出る辺は start_[v], ..., start_[v + 1] - 1 になり, 以降の DFS はメモリをおおむね順にたどる
+void LeftRight::relabel(int n, const std::vector<int>& pre) {
+  const int m = arc_.size();
+  std::vector<int> count(2 * n + 3), sorted(m), id(m);
+  for(const auto& a: arc_) ++count[a.nesting + 1];
+  for(int k = 0; k < 2 * n + 2; ++k) count[k + 1] += count[k];
+  for(int i = 0; i < m; ++i) sorted[count[arc_[i].nesting]++] = i;
+  start_.assign(n + 1, 0);
+  for(const auto& a: arc_) ++start_[pre[a.source] + 1];
+  for(int v = 0; v < n; ++v) start_[v + 1] += start_[v];
+  pos_.assign(std::begin(start_), std::end(start_) - 1);
+  for(auto i: sorted) id[i] = pos_[pre[arc_[i].source]]++;
+  std::vector<Arc> arc(m);
+  for(int i = 0; i < m; ++i) {
+    arc[id[i]] = arc_[i];
+    arc[id[i]].source = pre[arc_[i].source], arc[id[i]].target = pre[arc_[i].target];
+  }
+  arc_ = std::move(arc);
+  edge_.resize(m);
+  for(int i = 0; i < m; ++i) edge_[id[i]] = i;
+  vertex_.resize(n);
+  std::vector<int> height(n), parent(n);
+  for(int v = 0; v < n; ++v) vertex_[pre[v]] = v, height[pre[v]] = height_[v], parent[pre[v]] = parent_[v] == -1 ? -1 : id[parent_[v]];
+  height_ = std::move(height);
+  parent_ = std::move(parent);
+  for(auto& r: roots_) r = pre[r];
+  pos_.assign(std::begin(start_), std::end(start_) - 1);
+}
+
+// 各頂点から出る辺を nesting (符号付き) の昇順に out_ に並べる (計数ソート)
+void LeftRight::order(int n) {
+  const int m = arc_.size(), K = 4 * n + 3;   // nesting は [-(2n + 1), 2n + 1]
+  std::vector<int> count(K + 1), sorted(m);
+  for(const auto& a: arc_) ++count[a.nesting + 2 * n + 2];
+  for(int k = 0; k < K; ++k) count[k + 1] += count[k];
+  for(int i = 0; i < m; ++i) sorted[count[arc_[i].nesting + 2 * n + 1]++] = i;
+  pos_.assign(std::begin(start_), std::end(start_) - 1);
+  out_.resize(m);
+  for(auto i: sorted) out_[pos_[arc_[i].source]++] = i;
+  pos_.assign(std::begin(start_), std::end(start_) - 1);
+}
+
+// 平面的でないとき failed_ に衝突の根拠を残して false を返す
+//   P の根拠は lowpt が決め手になる 2 辺 lowpt_edge[e], lowpt_edge[ei] と, P にまとめた衝突対の根拠
+bool LeftRight::add_constraints(int ei, int e) {
+  ConflictPair P;
+  P.reason = make_reason(arc_[e].lowpt_edge, arc_[ei].lowpt_edge);
+  auto conflict = [&](const ConflictPair& Q) {
+    merge_reason(P.reason, Q.reason);
+    failed_ = P.reason;
+    return false;
+  };
+  // ei からの戻り辺を P.R にまとめる
+  do {
+    auto Q = S_.back();
+    S_.pop_back();
+    if(!Q.L.empty()) std::swap(Q.L, Q.R);
+    if(!Q.L.empty()) return conflict(Q);
+    if(arc_[Q.R.low].lowpt > arc_[e].lowpt) {
+      if(P.R.empty()) P.R.high = Q.R.high;
+      else arc_[P.R.low].ref = Q.R.high;
+      P.R.low = Q.R.low;
+      merge_reason(P.reason, Q.reason);
+    } else {
+      arc_[Q.R.low].ref = arc_[e].lowpt_edge;
+    }
+  } while((int)S_.size() != arc_[ei].bottom);
+  // それより前の辺からの戻り辺のうち, ei と衝突するものを P.L にまとめる
+  while(!S_.empty() && (conflicting(S_.back().L, ei) || conflicting(S_.back().R, ei))) {
+    auto Q = S_.back();
+    S_.pop_back();
+    if(conflicting(Q.R, ei)) std::swap(Q.L, Q.R);
+    if(conflicting(Q.R, ei)) return conflict(Q);
+    if(P.R.low != -1) arc_[P.R.low].ref = Q.R.high;
+    if(Q.R.low != -1) P.R.low = Q.R.low;
+    if(P.L.empty()) P.L.high = Q.L.high;
+    else arc_[P.L.low].ref = Q.L.high;
+    P.L.low = Q.L.low;
+    merge_reason(P.reason, Q.reason);
+  }
+  if(!P.L.empty() || !P.R.empty()) S_.emplace_back(P);
+  return true;
+}
+
+// 木の辺 e の始点 u に戻る辺を取り除く
+void LeftRight::remove_back_edges(int e) {
+  const int u = arc_[e].source;
+  while(!S_.empty() && lowest(S_.back()) == height_[u]) {
+    if(S_.back().L.low != -1) arc_[S_.back().L.low].side = -1;
+    S_.pop_back();
+  }
+  if(!S_.empty()) {
+    auto& P = S_.back();
+    while(P.L.high != -1 && arc_[P.L.high].target == u) P.L.high = arc_[P.L.high].ref;
+    if(P.L.high == -1 && P.L.low != -1) {
+      arc_[P.L.low].ref = P.R.low;
+      arc_[P.L.low].side = -1;
+      P.L.low = -1;
+    }
+    while(P.R.high != -1 && arc_[P.R.high].target == u) P.R.high = arc_[P.R.high].ref;
+    if(P.R.high == -1 && P.R.low != -1) {
+      arc_[P.R.low].ref = P.L.low;
+      arc_[P.R.low].side = -1;
+      P.R.low = -1;
+    }
+  }
+  // e の左右は最も高い戻り辺の左右にそろえる
+  if(arc_[e].lowpt < height_[u]) {
+    int hl = S_.back().L.high, hr = S_.back().R.high;
+    arc_[e].ref = hl != -1 && (hr == -1 || arc_[hl].lowpt > arc_[hr].lowpt) ? hl : hr;
+  }
+}
+
+// side[e] *= sign(ref[e]) を ref の先から順に確定させる
+int LeftRight::sign(int e) {
+  stack_.clear();
+  for(int f = e; arc_[f].ref != -1; f = arc_[f].ref) stack_.emplace_back(f);
+  if(stack_.empty()) return arc_[e].side;
+  for(int s = arc_[arc_[stack_.back()].ref].side; !stack_.empty(); stack_.pop_back()) {
+    auto& a = arc_[stack_.back()];
+    a.side *= s;
+    a.ref = -1;
+    s = a.side;
+  }
+  return arc_[e].side;
+}
+
+// DFS 木の辺と, failed_ から根拠をたどって集めた戻り辺を witness に入れる
+//   左右の制約は木の辺と根拠の戻り辺だけで決まっているので, この部分グラフでも同じ衝突が起きる
+bool LeftRight::fail() {
+  std::vector<bool> used(arc_.size());
+  auto use = [&](int i) {
+    if(!used[i]) used[i] = true, witness.emplace_back(edge_[i]);
+  };
+  for(auto i: parent_) if(i != -1) use(i);
+  stack_ = {failed_};
+  while(!stack_.empty()) {
+    const auto& r = reason_[stack_.back()];
+    stack_.pop_back();
+    use(r.a), use(r.b);
+    for(int c = r.child; c != -1; c = reason_[c].sibling) stack_.emplace_back(c);
+  }
+  return false;
+}
+
+bool LeftRight::operator()(int n, const std::vector<std::pair<Vertex, Vertex>>& edges, bool embed) {
+  const int m = edges.size();
+  rotation.clear();
+  witness.clear();
+  // 3n - 6 本より多ければ平面的でないが, 衝突を求めるために先頭の 3n - 5 本 (これも平面的でない) を判定する
+  if(2 < n && 3 * n - 5 < m) return (*this)(n, {std::begin(edges), std::begin(edges) + 3 * n - 5}, false);
+  // 向き付けと lowpt
+  std::vector<int> adjacent_start(n + 1);
+  std::vector<std::pair<int, Vertex>> adjacent(2 * m);   // (辺, 相手)
+  for(const auto& [u, v]: edges) ++adjacent_start[u + 1], ++adjacent_start[v + 1];
+  for(int v = 0; v < n; ++v) adjacent_start[v + 1] += adjacent_start[v];
+  pos_.assign(std::begin(adjacent_start), std::end(adjacent_start) - 1);
+  for(int i = 0; i < m; ++i) {
+    auto [u, v] = edges[i];
+    adjacent[pos_[u]++] = {i, v}, adjacent[pos_[v]++] = {i, u};
+  }
+  pos_.assign(std::begin(adjacent_start), std::end(adjacent_start) - 1);
+  height_.assign(n, -1);
+  parent_.assign(n, -1);
+  arc_.assign(m, {-1, -1, 0, 0, 0, -1, 1, 0, 0});
+  roots_.clear();
+  std::vector<int> pre(n);
+  int counter = 0;
+  // 辺 i = v → w を調べ終えたとき
+  auto finish = [&](int i) {
+    auto& a = arc_[i];
+    const int v = a.source, e = parent_[v];
+    a.nesting = 2 * a.lowpt + (a.lowpt2 < height_[v]);
+    if(e != -1) {
+      auto& b = arc_[e];
+      if(a.lowpt < b.lowpt) b.lowpt2 = std::min(b.lowpt, a.lowpt2), b.lowpt = a.lowpt;
+      else if(a.lowpt > b.lowpt) b.lowpt2 = std::min(b.lowpt2, a.lowpt);
+      else b.lowpt2 = std::min(b.lowpt2, a.lowpt2);
+    }
+    ++pos_[v];
+  };
+  for(int r = 0; r < n; ++r) {
+    if(height_[r] != -1) continue;
+    height_[r] = 0;
+    pre[r] = counter++;
+    roots_.emplace_back(r);
+    stack_ = {r};
+    while(!stack_.empty()) {
+      const int v = stack_.back();
+      if(pos_[v] == adjacent_start[v + 1]) {
+        stack_.pop_back();
+        if(parent_[v] != -1) finish(parent_[v]);
+        continue;
+      }
+      const auto [i, w] = adjacent[pos_[v]];
+      auto& a = arc_[i];
+      if(a.source != -1) {
+        ++pos_[v];
+        continue;
+      }
+      a.source = v, a.target = w;
+      a.lowpt = a.lowpt2 = height_[v];
+      if(height_[w] == -1) {
+        parent_[w] = i;
+        height_[w] = height_[v] + 1;
+        pre[w] = counter++;
+        stack_.emplace_back(w);
+        continue;
+      }
+      a.lowpt = height_[w];
+      finish(i);
+    }
+  }
+
+  // 左右の制約
+  relabel(n, pre);
+  S_.clear();
+  reason_.clear();
+  // 辺 ei = v → w を調べ終えたとき, 戻り辺を v の制約に加える
+  auto integrate = [&](int ei) {
+    const int v = arc_[ei].source;
+    ++pos_[v];
+    if(arc_[ei].lowpt < height_[v]) {
+      if(ei == start_[v]) arc_[parent_[v]].lowpt_edge = arc_[ei].lowpt_edge;
+      else if(!add_constraints(ei, parent_[v])) return false;
+    }
+    return true;
+  };
+  for(auto r: roots_) {
+    stack_ = {r};
+    while(!stack_.empty()) {
+      const int v = stack_.back();
+      if(pos_[v] == start_[v + 1]) {
+        stack_.pop_back();
+        if(const int e = parent_[v]; e != -1) {
+          remove_back_edges(e);
+          if(!integrate(e)) return fail();
+        }
+        continue;
+      }
+      const int ei = pos_[v];
+      auto& a = arc_[ei];
+      a.bottom = S_.size();
+      if(ei == parent_[a.target]) {
+        stack_.emplace_back(a.target);
+        continue;
+      }
+      a.lowpt_edge = ei;
+      S_.push_back({{}, {ei, ei}, make_reason(ei, ei)});
+      if(!integrate(ei)) return fail();
+    }
+  }
+  if(!embed) return true;
+
+  // 埋め込み: 各頂点のまわりの半辺 (2i は arc_[i].source 側, 2i + 1 は arc_[i].target 側) を循環リストで持つ
+  for(int i = 0; i < m; ++i) arc_[i].nesting *= sign(i);
+  order(n);
+  struct Around {int cw, ccw;};
+  std::vector<Around> around(2 * m);
+  std::vector<int> first(n, -1), left(n), right(n);
+  auto insert_cw = [&](int v, int h, int reference) {
+    if(reference == -1) {
+      around[h] = {h, h};
+      first[v] = h;
+      return;
+    }
+    around[h] = {around[reference].cw, reference};
+    around[around[reference].cw].ccw = h, around[reference].cw = h;
+  };
+  auto insert_ccw = [&](int v, int h, int reference) {
+    insert_cw(v, h, reference == -1 ? -1 : around[reference].ccw);
+    if(reference != -1 && first[v] == reference) first[v] = h;
+  };
+  for(int v = 0; v < n; ++v) for(int k = start_[v]; k < start_[v + 1]; ++k) insert_cw(v, 2 * out_[k], k == start_[v] ? -1 : 2 * out_[k - 1]);
+  for(auto r: roots_) {
+    stack_ = {r};
+    while(!stack_.empty()) {
+      const int v = stack_.back();
+      if(pos_[v] == start_[v + 1]) {
+        stack_.pop_back();
+        continue;
+      }
+      const int i = out_[pos_[v]++], w = arc_[i].target;
+      if(i == parent_[w]) {
+        insert_ccw(w, 2 * i + 1, first[w]);
+        left[v] = right[v] = 2 * i;
+        stack_.emplace_back(w);
+      } else if(arc_[i].side == 1) {
+        insert_cw(w, 2 * i + 1, right[w]);
+      } else {
+        insert_ccw(w, 2 * i + 1, left[w]);
+        left[w] = 2 * i + 1;
+      }
+    }
+  }
+  rotation.resize(n);
+  for(int u = 0; u < n; ++u) {
+    const int v = pre[u];
+    if(first[v] == -1) continue;
+    rotation[u].reserve(adjacent_start[u + 1] - adjacent_start[u]);
+    int h = first[v];
+    do {
+      rotation[u].emplace_back(vertex_[h % 2 ? arc_[h / 2].source : arc_[h / 2].target]);
+      h = around[h].ccw;
+    } while(h != first[v]);
+  }
+  return true;
+}
+
+// 頂点数 n の平面的でない単純グラフ edges から, Kuratowski の細分になっている辺の番号を求める
+//   witness: 判定で得た LeftRight::witness (この辺から始める)
+std::vector<int> kuratowski(int n, const std::vector<std::pair<Vertex, Vertex>>& edges, const std::vector<int>& witness) {
+  const int m = edges.size();
+  LeftRight test;
+  std::mt19937 rng(1);
+  // 道 j は辺 head[j], link[head[j]], ... からなり, 端点は end[j]; 他の道にまとめられたら alias[j] がその道
+  std::vector<std::pair<Vertex, Vertex>> end(edges);
+  std::vector<int> head(m), tail(m), link(m, -1), alias(m), items(witness);   // items: 残っている道
+  std::vector<bool> alive(m), required(m);
+  for(int j = 0; j < m; ++j) head[j] = tail[j] = alias[j] = j;
+  for(auto j: witness) alive[j] = true;
+  auto find = [&](int j) {
+    while(alias[j] != j) j = alias[j] = alias[alias[j]];
+    return j;
+  };
+  std::vector<int> degree(n), offset(n), last(n), id(n, -1), touched, incident, queue, C;
+  // 次数 1 の頂点につながる道を除き, 次数 2 の頂点を通る道をまとめる
+  auto reduce = [&]() {
+    std::erase_if(items, [&](int j) {return !alive[j];});
+    touched.clear();
+    for(auto j: items) for(auto v: {end[j].first, end[j].second}) if(degree[v]++ == 0) touched.emplace_back(v);
+    int total = 0;
+    for(auto v: touched) offset[v] = last[v] = total, total += degree[v];
+    incident.resize(total);
+    for(auto j: items) incident[last[end[j].first]++] = j, incident[last[end[j].second]++] = j;
+    queue.clear();
+    for(auto v: touched) if(degree[v] <= 2) queue.emplace_back(v);
+    while(!queue.empty()) {
+      const int v = queue.back();
+      queue.pop_back();
+      if(degree[v] == 0 || 2 < degree[v]) continue;
+      int a = -1, b = -1;
+      for(int k = offset[v]; k < last[v]; ++k) {
+        int j = find(incident[k]);
+        if(!alive[j]) continue;
+        if(a == -1) a = j;
+        else if(a != j) b = j;
+      }
+      if(degree[v] == 1) {
+        if(required[a]) continue;
+        alive[a] = false;
+        degree[v] = 0;
+        int w = end[a].first == v ? end[a].second : end[a].first;
+        if(--degree[w] <= 2) queue.emplace_back(w);
+        continue;
+      }
+      if(b == -1) continue;   // 1 本の道が v から出て v に戻っている
+      // 道 a, b を v でつなぐ
+      int x = end[a].first == v ? end[a].second : end[a].first, y = end[b].first == v ? end[b].second : end[b].first;
+      link[tail[a]] = head[b];
+      tail[a] = tail[b];
+      end[a] = {x, y};
+      required[a] = required[a] || required[b];
+      alive[b] = false;
+      alias[b] = a;
+      degree[v] = 0;
+      if(x == y && !required[a]) {
+        alive[a] = false;
+        if((degree[x] -= 2) <= 2) queue.emplace_back(x);
+      }
+    }
+    for(auto v: touched) degree[v] = 0;
+    std::erase_if(items, [&](int j) {return !alive[j];});
+  };
+  // 残っている道のうち skip でないものからなるグラフが平面的か
+  //   頂点は道の番号順に現れた順に付け直す (もとのグラフの番号の近さがなるべく保たれる)
+  //   平面的でなければ, 残っている道を判定の witness と R に絞る (これも平面的でない)
+  std::vector<bool> skip(m);
+  std::vector<std::pair<Vertex, Vertex>> local, simple;
+  std::vector<Vertex> global;
+  std::vector<int> bucket, seen, origin, path;   // local[t] は道 origin[t], simple[t] は道 path[t]
+  auto planar = [&]() {
+    local.clear();
+    global.clear();
+    origin.clear();
+    for(auto j: items) {
+      if(skip[j]) continue;
+      auto [u, v] = end[j];
+      if(id[u] == -1) id[u] = global.size(), global.emplace_back(u);
+      if(id[v] == -1) id[v] = global.size(), global.emplace_back(v);
+      if(u != v) local.emplace_back(std::min(id[u], id[v]), std::max(id[u], id[v])), origin.emplace_back(j);
+    }
+    for(auto v: global) id[v] = -1;
+    // 同じ端点の道は 1 本だけ使う
+    const int N = global.size();
+    bucket.assign(N + 1, 0);
+    seen.assign(N, -1);
+    for(const auto& e: local) ++bucket[e.first + 1];
+    for(int u = 0; u < N; ++u) bucket[u + 1] += bucket[u];
+    simple.resize(local.size());
+    path.resize(local.size());
+    for(std::size_t t = 0; t < local.size(); ++t) path[bucket[local[t].first]] = origin[t], simple[bucket[local[t].first]++] = local[t];
+    int k = 0;
+    for(int u = 0, t = 0; u < N; ++u) for(; t < bucket[u]; ++t) if(seen[simple[t].second] != u) seen[simple[t].second] = u, path[k] = path[t], simple[k++] = simple[t];
+    simple.resize(k);
+    if(test(N, simple, false)) return true;
+    for(auto j: items) alive[j] = required[j];
+    for(auto t: test.witness) alive[path[t]] = true;
+    return false;
+  };
+  // 残っている道は常に非平面; R 以外の道 C から chunk 本を除いても非平面なら除き, 平面的になるなら chunk を減らす
+  //   witness が平面的になることはないはずだが, そのときはすべての辺から始める
+  if(planar()) {
+    items.resize(m);
+    for(int j = 0; j < m; ++j) alive[j] = true, items[j] = j;
+    planar();
+  }
+  for(std::size_t chunk = m; ; ) {
+    reduce();
+    C.clear();
+    for(auto j: items) if(!required[j]) C.emplace_back(j);
+    if(C.empty()) break;
+    std::shuffle(std::begin(C), std::end(C), rng);
+    chunk = std::clamp(chunk, std::size_t(1), (C.size() + 1) / 2);
+    for(std::size_t k = C.size() - chunk; k < C.size(); ++k) skip[C[k]] = true;
+    bool result = planar();
+    for(std::size_t k = C.size() - chunk; k < C.size(); ++k) skip[C[k]] = false;
+    if(!result) {
+      for(std::size_t k = C.size() - chunk; k < C.size(); ++k) alive[C[k]] = false;
+      chunk *= 2;
+    } else if(chunk == 1) {
+      required[C.back()] = true;
+    } else {
+      chunk /= 2;
+    }
+  }
+  assert(!planar());
+  // 道を 1 本ずつ他の道を通らない最短路 (BFS) に付け替える
+  //   owner[v]: v を内部に持つ道 (分岐点は -2); 付け替えても道は内部で交わらないので細分のまま
+  std::vector<int> adjacent_start(n + 1), owner(n, -1), mark(n, -1), via(n), result;
+  std::vector<std::pair<int, Vertex>> adjacent(2 * m);   // (辺, 相手)
+  for(const auto& [u, v]: edges) ++adjacent_start[u + 1], ++adjacent_start[v + 1];
+  for(int v = 0; v < n; ++v) adjacent_start[v + 1] += adjacent_start[v];
+  std::copy(std::begin(adjacent_start), std::end(adjacent_start) - 1, std::begin(last));
+  for(int i = 0; i < m; ++i) {
+    auto [u, v] = edges[i];
+    adjacent[last[u]++] = {i, v}, adjacent[last[v]++] = {i, u};
+  }
+  for(auto j: items) for(int i = head[j]; i != -1; i = link[i]) owner[edges[i].first] = owner[edges[i].second] = j;
+  for(auto j: items) owner[end[j].first] = owner[end[j].second] = -2;
+  for(auto j: items) {
+    const auto [s, t] = end[j];
+    queue = {s};
+    mark[s] = j;
+    for(std::size_t k = 0; mark[t] != j; ++k) {
+      const int v = queue[k];
+      for(int a = adjacent_start[v]; a < adjacent_start[v + 1]; ++a) {
+        auto [i, w] = adjacent[a];
+        if(mark[w] == j || (w != t && owner[w] != -1 && owner[w] != j)) continue;
+        mark[w] = j, via[w] = i;
+        queue.emplace_back(w);
+      }
+    }
+    for(int i = head[j]; i != -1; i = link[i]) for(auto v: {edges[i].first, edges[i].second}) if(owner[v] == j) owner[v] = -1;
+    for(int v = t; v != s; ) {
+      const int i = via[v];
+      result.emplace_back(i);
+      v = edges[i].first == v ? edges[i].second : edges[i].first;
+      if(v != s) owner[v] = j;
+    }
+  }
+  std::sort(std::begin(result), std::end(result));
+  return result;
+}
+
+struct Planarity {
+  bool planar;
+  std::vector<std::vector<Vertex>> rotation;
+  std::vector<Edge> kuratowski;
+};
+
+Planarity planarity(const Graph& G) {
+  const int n = G.size();
+  // 単純グラフにする (辺 u - v (u < v) は G[u] にあるものを使う)
+  std::vector<std::pair<Vertex, Vertex>> edges;
+  std::vector<int> original;   // edges[i] は G[edges[i].first][original[i]]
+  std::vector<int> mark(n, -1);
+  for(Vertex u = 0; u < n; ++u) {
+    for(std::size_t k = 0; k < G[u].size(); ++k) {
+      Vertex v = G[u][k].to;
+      if(v <= u || mark[v] == u) continue;
+      mark[v] = u;
+      edges.emplace_back(u, v);
+      original.emplace_back(k);
+    }
+  }
+  Planarity result;
+  LeftRight test;
+  result.planar = test(n, edges, true);
+  if(result.planar) {
+    result.rotation = std::move(test.rotation);
+  } else {
+    for(auto i: kuratowski(n, edges, test.witness)) result.kuratowski.emplace_back(G[edges[i].first][original[i]]);
+  }
+  return result;
+}
+
+#include<iostream>
+#include<chrono>
+#include<random>
+using namespace std;
+
+int main() {
+  auto insert = [](Graph& G, Vertex u, Vertex v) {
+    G[u].push_back({u, v, 1});
+    G[v].push_back({v, u, 1});
+  };
+  /*
+  // ベンチマーク (1 コア, k * k の格子に対角線を加えた三角形分割: k = 1000 で頂点数 10^6, 辺数 3 * 10^6)
+  //   平面的: 回転系まで 1650ms
+  //   内部の離れた 2 頂点を結ぶ辺を加えると非平面: Kuratowski 部分グラフ (辺数 1035) まで 1800ms
+  //   (頂点数 10^6, ランダムな辺 1.5 * 10^6 本のグラフなら Kuratowski 部分グラフ (辺数 130) まで 2550ms)
+  for(int extra = 0; extra < 2; ++extra) {
+    int k = 1000;
+    Graph G(k * k);
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) {
+      if(i + 1 < k) insert(G, i * k + j, (i + 1) * k + j);
+      if(j + 1 < k) insert(G, i * k + j, i * k + j + 1);
+      if(i + 1 < k && j + 1 < k) insert(G, i * k + j, (i + 1) * k + j + 1);
+    }
+    if(extra) insert(G, k + 1, (k - 2) * k + k - 3);
+    auto start = chrono::steady_clock::now();
+    auto P = planarity(G);
+    auto end = chrono::steady_clock::now();
+    cout << P.planar << " " << P.kuratowski.size() << " " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+  }
+  */
+
+  // K4 (平面的)
+  Graph G(4);
+  for(int u = 0; u < 4; ++u) for(int v = u + 1; v < 4; ++v) insert(G, u, v);
+  auto P = planarity(G);
+  cout << P.planar << endl;
+  for(int v = 0; v < 4; ++v) {
+    cout << v << ":";
+    for(auto w: P.rotation[v]) cout << " " << w;
+    cout << endl;
+  }
+  // Petersen グラフ (K3,3 の細分を含む)
+  Graph H(10);
+  for(int i = 0; i < 5; ++i) insert(H, i, (i + 1) % 5), insert(H, i, i + 5), insert(H, i + 5, (i + 2) % 5 + 5);
+  P = planarity(H);
+  cout << P.planar << endl;
+  for(const auto& e: P.kuratowski) cout << e.from << " - " << e.to << endl;
+}
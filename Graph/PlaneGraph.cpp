@@ -25,117 +25,969 @@
 // 定理 (Lipton & Tarjan): 平面グラフは sqrt(n) 個のセパレータを含み, それは O(n) で構築可能.
 // 定理 (A simple MAX-CUT algorithm for planar graphs): 最大カットを O(n^1.5 log n) で計算可能.
 
-// insert(vertex)  頂点を追加 O(1)
-// insert(u,v)     辺を追加 O(1)
-// dualgraph()     双対グラフを作成 O(|V| + |E| log |E|)
-//                   解説: http://kanetai.hatenablog.com/entry/20140321/1395414246
-//                   双対グラフの頂点の座標は多角形の重心にしてある.
-//                   隣接リストをソートするので他の関数との兼ね合いに注意.
-//                   外側領域を求めたい場合:
-//                     (1) 最小 x 座標の頂点 v を求める.
-//                     (2) G[v] を偏角順にソート.
-//                     (3) PI < |arg(E[G[v][i+1]] - arg(E[G[v][i]])| であるような E[i] が外側領域の一部である.
+// 半辺構造 (doubly-connected edge list)
+//   辺 k は半辺 2k (u → v) と 2k + 1 (v → u) からなり, twin(h) = h ^ 1
+//   半辺 h の左側の面を face(h), 面を左に見て h の次にたどる半辺を next(h) とする
+//   to, next, face は半辺ごとの配列, 各頂点から出る半辺 (偏角順) と各面の境界の半辺 (たどる順) は CSR で持つ
+//   座標は整数で, |x|, |y| <= 10^9 とする (外積が long long に収まる)
+//   辺どうしは端点以外で交わらないとする (同じ向きに重なる辺もないとする)
+
+// insert(point)   頂点を追加 O(1)
+// insert(u, v)    辺を追加して, 半辺 u → v の番号を返す O(1)
+// build()         半辺構造を作る O(|V| + |E| log |E|)
+//                   各頂点から出る半辺を偏角順にソートする (上半平面か下半平面か → 外積で比べる, 浮動小数点数を使わない)
+//                   next(h) は to(h) から出る半辺のうち, twin(h) の 1 つ前 (時計回りに次) のもの
+//                   面は next をたどるループで列挙する (再帰しない)
+//                   外側の面: 連結成分ごとに最も下 (同じなら最も左) の頂点から, 偏角が最大の半辺の左側の面
+//                   非連結なら連結成分ごとに外側の面がある (面の入れ子は扱わない)
+// build(rotation) 回転系から半辺構造を作る O(|V| + |E|) (Planarity.cpp の埋め込みをそのまま渡せる)
+//                   rotation[v] は v に隣接する頂点を反時計回りに並べたもの (自己ループ, 多重辺はないとする)
+//                   それまでに追加した辺は捨てる; 辺 k は u < v として rotation[u] に現れる順に番号を付ける
+//                   座標は使わないので, 外側の面は連結成分ごとに境界の最も長い面とする (PointLocation は使えない)
+// dualgraph()     双対グラフ O(|E|)
+//                   面 f の境界の半辺 h ごとに, 面 face(twin(h)) への弧を持つ (多重辺と, 橋による自己ループを含む)
+//                   弧 k は edge[k] の半辺と交わる
+// separator(vertices)  vertices が誘導する部分グラフのセパレータ S と, 残りの分割 A, B O(n log n) (n = |vertices|)
+//                   A, B を直接結ぶ辺はなく, 頂点数はそれぞれ 2n/3 程度以下
+//                   埋め込みは G のものを使い, 部分グラフの面を作り直す
+//                   2n/3 より大きい連結成分 K があれば, K について次の 2 つのうち小さい方を S とする
+//                     BFS の層: 上下の層の頂点数がどちらも 2|K|/3 以下になる層のうち最小のもの
+//                     基本閉路: 面を三角形に分割し (長さ 3 でない面には仮想の頂点を置いて扇状に結ぶ),
+//                               BFS 木に含まれない辺 e ごとの基本閉路を考える
+//                               木に含まれない辺は双対グラフの全域木をなし, e で切った双対木の片側の三角形数 F と
+//                               閉路の長さ |C| から, 内側の頂点数が (F - |C| + 2) / 2 (オイラーの公式) とわかる
+//                               仮想の頂点は双対木の部分木ごとに数えて引く, LCA は Tarjan のオフライン法で求める
+//                   S を除いた連結成分を, 大きいものから A, B の小さい方へ入れる
+//                   (Lipton-Tarjan の層を縮約する手順は省いているので, |S| は O(sqrt(n)) ではなく O(BFS の深さ))
+// division(r)     頂点数 r 以下 (r >= 2) の piece に分ける
+//                   保証するのは「どの piece も頂点数 r 以下」と「どの辺も両端を含む piece がある」ことだけ
+//                   頂点数が r より大きい piece を separator で A ∪ S, B ∪ S に分けることを繰り返す
+//                   A か B が空で分けられないとき (K4 など) は, piece の中で次数最小の頂点 v を除いた piece と,
+//                   v とその隣接頂点を r - 1 個ずつ組にした piece (v の星) に分ける
+//                   piece p の頂点は vertex[start[p]], ..., vertex[start[p + 1] - 1] で,
+//                   boundary[k] は vertex[k] が 2 つ以上の piece に含まれるか
+//                   (r-division ではない: separator は O(sqrt(n)) ではなく O(BFS の深さ) で, 境界の頂点が多い piece を
+//                    さらに分ける Frederickson の手順も省いているので, 境界の頂点数と piece の数は抑えられない;
+//                    格子などでは O(n log^2 n) 程度だが, 計算量の上界も示していない)
+// minimum_cut(s, t, capacity)  s-t 最小カット (= 最大流) を双対グラフの最短路で求める
+//                   capacity[h] は半辺 h の向きの容量 (0 以上, 大きさ 2|E|)
+//                   Cut::edges はカットの半辺 (s 側から t 側へ向かうもの), Cut::value はその容量の和
+//                   s から t へ辺をたどって行けない (連結成分が異なる) ときは {0, {}, {}} を返す
+//                   s, t が同じ面 f の境界にあるとき O(n log n):
+//                     f を s と t を結ぶ仮想の辺で 2 つに分け, 半辺 h ごとに face(h) → face(twin(h)) へ
+//                     長さ capacity[h] の弧を張った双対グラフで, 分けた面どうしの最短路がカットになる
+//                     Cut::flow[h] は半辺 h の向きの流量 (flow[twin(h)] = -flow[h]) で,
+//                     距離 d を最短路長で打ち切ったものとして flow[h] = d(face(twin(h))) - d(face(h)) (Hassin)
+//                   そうでなく, 容量が向きによって異なるとき: 半辺を弧とする Dinic O(n^2 |E|) (Cut::flow も返す)
+//                     twin(h) が h の残余グラフでの逆辺になるので, 流量を半辺ごとに持つだけでよい
+//                     (向きのある平面グラフの O(n log n) の方法 (Borradaile-Klein) は省いている)
+//                   そうでなく, 容量が向きによらないとき:
+//                     s-t 経路 P と奇数回交わる双対グラフの閉路のうち最短のものを, P の左側の面ごとに
+//                     (面, 交わった回数の偶奇) の 2 倍のグラフで Dijkstra をして求める (Cut::flow は空)
+//                     P は BFS で辺数を最小にし, Dijkstra の回数 k は P の左側の面の種類数 (k <= |P| <= n - 1)
+//                     計算量は O(k n log n) で, s, t が離れていれば最悪 O(n^2 log n) (格子の対角なら O(n^1.5 log n))
+//                     (P を分割統治して O(n log^2 n) にする Reif の手順は省いている)
+
+// PointLocation: 点を含む面を求める (面の番号は build(), dualgraph() と同じ)
+//   永続的な slab 法: 頂点の x 座標で平面を縦の帯 (slab) に分け, 左から掃引しながら
+//   帯を横切る辺を下から順に並べた平衡二分木 (treap) を, 変更のある節点だけ複製して帯ごとに残す
+//     構築 O(|E| log |E|) 期待値, 節点数 O(|E| log |E|) 期待値
+//     同じ x で終わる辺を (x - ε での順序で) 除いてから, 始まる辺を (x + ε での順序で) 加える
+//     比較は整数 (__int128) で行う
+//   locate(p)            O(log |E|) 期待値
+//                        p の真下 (p を通るものを含む) で最も上の辺を求め, その辺の上側の面を返す
+//                        下に辺がないときは, p の真上で最も下の辺の下側の面を返す
+//                        p.x を含む帯を横切る辺がない (p がどの辺の x 座標の範囲にも入らない) ときだけ -1 を返す
+//                        辺や頂点の上の点, 面の入れ子 (外側の面の中の別の連結成分) は区別しない
+//   locate(points, threads)  まとめて求める
+//                        x 座標でソートして, 近い点を同じスレッドが続けて調べるように分ける
+//                        ※ threads > 1 のときは -pthread を付けてコンパイルする
 
 #include<algorithm>
 #include<cassert>
-#include<cmath>
+#include<cstdint>
 #include<functional>
 #include<iostream>
-#include<unordered_map>
-#include<unordered_set>
+#include<limits>
+#include<numeric>
+#include<queue>
+#include<span>
+#include<thread>
 #include<vector>
 
-struct Vertex {double x, y;};
-
-struct Edge {
-  int from, to, rev;
-  Edge(int from, int to, int rev) : from(from), to(to), rev(rev) {}
-};
+struct Point {long long x, y;};
 
 class PlaneGraph {
  public:
-  int size() const {return V.size();}
-  Vertex& vertex(int i) {return V.at(i);}
-  void insert(const Vertex& v) {
-    V.emplace_back(v);
-    G.resize(V.size());
-  }
-  void insert(int u, int v) {
-    assert(u<V.size() && v<V.size());
-    G[u].emplace_back(E.size());
-    G[v].emplace_back(E.size() + 1);
-    E.emplace_back(u, v, E.size() + 1);
-    E.emplace_back(v, u, E.size() - 1);
-  }
-  void debug() const {
-    std::cout<<"*Vertices*"<<std::endl;
-    for(auto i=0; i<V.size(); ++i) {std::cout<<i<<": ("<<V[i].x<<", "<<V[i].y<<")"<<std::endl;}
-    std::cout<<"*Edges*"<<std::endl;
-    for(auto i=0; i<E.size(); ++i) {auto e=E[i]; std::cout<<i<<": "<<e.from<<" to " <<e.to<<", rev = "<<e.rev<<", arg = "<<arg(e)<<std::endl;}
-    std::cout<<"*Adjacency List*"<<std::endl;
-    for(auto i=0; i<G.size(); ++i) {std::cout<<i<<":"; for(auto j: G[i]) std::cout<<" "<<j; std::cout<<std::endl;}
-  }
-  PlaneGraph dualgraph() {
-    // Sort edges by angle.
-    std::vector<int> pre(E.size());
-    for(auto& list: G) {
-      std::sort(std::begin(list), std::end(list), [&](auto l, auto r) {return arg(E[l]) < arg(E[r]);});
-      for(auto i=0; i<list.size(); ++i) pre[list[(i+1)%list.size()]] = list[i];
-    }
-    // Color edges.
-    std::vector<std::unordered_map<int, int>> color(G.size());
-    int c = 0;
-    std::function<void(const Edge&)> dfs = [&](const auto& e) {
-      color[e.from][e.to] = c;
-      const auto& nex = E[pre[e.rev]];
-      if(!color[nex.from].count(nex.to)) dfs(nex);
-    };
-    for(const auto& list: G) for(auto i: list) if(!color[E[i].from].count(E[i].to)) dfs(E[i]), ++c;
-    // Construct the dualgraph.
-    PlaneGraph H;
-    for(auto i=0; i<c; ++i) H.insert(Vertex());
-    std::vector<int> cnt(c);
-    for(const auto& e: E) {
-      auto i = color[e.from][e.to];
-      H.vertex(i).x += V[e.from].x;
-      H.vertex(i).y += V[e.from].y;
-      ++cnt[i];
-    }
-    for(auto i=0; i<c; ++i) H.vertex(i).x /= cnt[i], H.vertex(i).y /= cnt[i];
-    std::vector<std::unordered_set<int>> used(c);
-    for(const auto& list: G) for(auto i: list) {
-      auto u = color[E[i].from][E[i].to], v = color[E[i].to][E[i].from];
-      if(u == v || used[u].count(v) || used[v].count(u)) continue;
-      used[u].emplace(v);
-      used[v].emplace(u);
-      H.insert(u, v);
-    }
-    return H;
+  // 面 f から出る弧は to[start[f]], ..., to[start[f + 1] - 1] で, 弧 k は半辺 edge[k] と交わる
+  struct Dual {std::vector<int> start, to, edge;};
+  int size() const {return point_.size();}
+  int edges() const {return to_.size() / 2;}
+  int faces() const {return face_start_.size() - 1;}
+  const Point& point(int v) const {return point_[v];}
+  int insert(const Point& p) {
+    point_.emplace_back(p);
+    return point_.size() - 1;
   }
+  int insert(int u, int v) {
+    assert(u < size() && v < size());
+    to_.emplace_back(v);
+    to_.emplace_back(u);
+    return to_.size() - 2;
+  }
+  void build();
+  void build(const std::vector<std::vector<int>>& rotation);
+  static int twin(int h) {return h ^ 1;}
+  int from(int h) const {return to_[h ^ 1];}
+  int to(int h) const {return to_[h];}
+  int next(int h) const {return next_[h];}
+  int face(int h) const {return face_[h];}
+  bool outer(int f) const {return outer_[f];}
+  std::span<const int> rotation(int v) const {return {rotation_.data() + vertex_start_[v], rotation_.data() + vertex_start_[v + 1]};}
+  std::span<const int> boundary(int f) const {return {boundary_.data() + face_start_[f], boundary_.data() + face_start_[f + 1]};}
+  // A, B, S はもとのグラフの頂点番号
+  struct Separator {std::vector<int> A, B, S;};
+  struct Division {std::vector<int> start, vertex; std::vector<bool> boundary;};
+  Dual dualgraph() const;
+  Separator separator(const std::vector<int>& vertices) const {
+    std::vector<int> local(size(), -1), local_edge(to_.size(), -1);
+    return separate(vertices, local, local_edge);
+  }
+  Division division(int r) const;
+  struct Cut {long long value; std::vector<int> edges; std::vector<long long> flow;};
+  Cut minimum_cut(int s, int t, const std::vector<long long>& capacity) const;
+  void debug() const;
  private:
-  inline double arg(const Edge& e) const {return std::atan2(V[e.to].y - V[e.from].y, V[e.to].x - V[e.from].x);}
-  std::vector<Vertex> V;
-  std::vector<Edge> E;
-  std::vector<std::vector<int>> G;
+  std::vector<Point> point_;
+  std::vector<int> to_, next_, face_;
+  std::vector<int> vertex_start_, rotation_;   // 頂点 v から出る半辺 (偏角順)
+  std::vector<int> face_start_, boundary_;     // 面 f の境界の半辺 (next の順)
+  std::vector<bool> outer_;
+  // 偏角の範囲 [0, π) なら 0, [π, 2π) なら 1
+  static int half(long long dx, long long dy) {return dy < 0 || (dy == 0 && dx < 0);}
+  bool less(int a, int b) const;
+  void link(bool geometric);
+  Separator separate(const std::vector<int>&, std::vector<int>&, std::vector<int>&) const;
+  Cut dinic(int s, int t, const std::vector<long long>& capacity) const;
 };
 
+// 半辺 a, b が同じ頂点から出るとき, a の偏角が b より小さいか
+bool PlaneGraph::less(int a, int b) const {
+  const auto &o = point_[from(a)], &p = point_[to(a)], &q = point_[to(b)];
+  long long ax = p.x - o.x, ay = p.y - o.y, bx = q.x - o.x, by = q.y - o.y;
+  auto s = half(ax, ay), t = half(bx, by);
+  if(s != t) return s < t;
+  return 0 < ax * by - ay * bx;
+}
+
+void PlaneGraph::build() {
+  const int n = size(), H = to_.size();
+  // 各頂点から出る半辺を偏角順に並べる
+  vertex_start_.assign(n + 1, 0);
+  for(int h = 0; h < H; ++h) ++vertex_start_[from(h) + 1];
+  for(int v = 0; v < n; ++v) vertex_start_[v + 1] += vertex_start_[v];
+  rotation_.resize(H);
+  {
+    auto pos = vertex_start_;
+    for(int h = 0; h < H; ++h) rotation_[pos[from(h)]++] = h;
+  }
+  for(int v = 0; v < n; ++v) {
+    auto first = std::begin(rotation_) + vertex_start_[v], last = std::begin(rotation_) + vertex_start_[v + 1];
+    std::sort(first, last, [&](int a, int b) {return less(a, b);});
+  }
+  link(true);
+}
+
+void PlaneGraph::build(const std::vector<std::vector<int>>& rotation) {
+  const int n = rotation.size();
+  if(size() < n) point_.resize(n, {0, 0});
+  vertex_start_.assign(size() + 1, 0);
+  std::vector<int> start(size() + 1);   // u < v の辺 u - v を v ごとに集める
+  for(int u = 0; u < n; ++u) {
+    vertex_start_[u + 1] = rotation[u].size();
+    for(auto v: rotation[u]) assert(u != v), start[v + 1] += u < v;
+  }
+  for(int v = 0; v < size(); ++v) vertex_start_[v + 1] += vertex_start_[v], start[v + 1] += start[v];
+  to_.clear();
+  rotation_.resize(vertex_start_.back());
+  std::vector<int> incoming(start.back());
+  {
+    auto pos = start;
+    for(int u = 0; u < n; ++u) {
+      for(std::size_t i = 0; i < rotation[u].size(); ++i) {
+        int v = rotation[u][i];
+        if(u < v) rotation_[vertex_start_[u] + i] = incoming[pos[v]++] = insert(u, v);
+      }
+    }
+  }
+  assert(2 * start.back() == vertex_start_.back());
+  std::vector<int> mark(size(), -1);
+  for(int v = 0; v < n; ++v) {
+    for(int i = start[v]; i < start[v + 1]; ++i) mark[from(incoming[i])] = twin(incoming[i]);
+    for(std::size_t i = 0; i < rotation[v].size(); ++i) {
+      int u = rotation[v][i];
+      if(v < u) continue;
+      assert(mark[u] != -1);
+      rotation_[vertex_start_[v] + i] = mark[u];
+      mark[u] = -1;
+    }
+  }
+  link(false);
+}
+
+// rotation_ (各頂点から出る半辺を反時計回りに並べたもの) から next, 面, 外側の面を求める
+void PlaneGraph::link(bool geometric) {
+  const int n = size(), H = to_.size();
+  next_.resize(H);
+  for(int v = 0; v < n; ++v) {
+    auto first = std::begin(rotation_) + vertex_start_[v], last = std::begin(rotation_) + vertex_start_[v + 1];
+    // twin(h) の 1 つ前の半辺が next(h)
+    for(auto i = first; i != last; ++i) next_[twin(i + 1 == last ? *first : *(i + 1))] = *i;
+  }
+  // 面を列挙する
+  face_.assign(H, -1);
+  face_start_ = {0};
+  boundary_.clear();
+  boundary_.reserve(H);
+  for(int h = 0; h < H; ++h) {
+    if(face_[h] != -1) continue;
+    int f = face_start_.size() - 1;
+    for(int g = h; face_[g] == -1; g = next_[g]) face_[g] = f, boundary_.emplace_back(g);
+    face_start_.emplace_back(boundary_.size());
+  }
+  // 連結成分ごとの外側の面
+  outer_.assign(faces(), false);
+  std::vector<bool> visited(n);
+  std::vector<int> stack;
+  for(int s = 0; s < n; ++s) {
+    if(visited[s] || vertex_start_[s] == vertex_start_[s + 1]) continue;
+    int low = s, longest = face_[rotation_[vertex_start_[s]]];
+    visited[s] = true;
+    stack.emplace_back(s);
+    while(!stack.empty()) {
+      int v = stack.back();
+      stack.pop_back();
+      const auto &p = point_[v], &q = point_[low];
+      if(p.y < q.y || (p.y == q.y && p.x < q.x)) low = v;
+      for(auto h: rotation(v)) {
+        if(boundary(longest).size() < boundary(face_[h]).size()) longest = face_[h];
+        if(!visited[to(h)]) visited[to(h)] = true, stack.emplace_back(to(h));
+      }
+    }
+    outer_[geometric ? face_[rotation(low).back()] : longest] = true;
+  }
+}
+
+PlaneGraph::Dual PlaneGraph::dualgraph() const {
+  Dual D{face_start_, std::vector<int>(boundary_.size()), boundary_};
+  for(std::size_t k = 0; k < boundary_.size(); ++k) D.to[k] = face_[twin(boundary_[k])];
+  return D;
+}
+
+// local, local_edge は大きさ |V|, 2|E| で -1 を入れておく (使い終わったら -1 に戻す)
+PlaneGraph::Separator PlaneGraph::separate(const std::vector<int>& vertices, std::vector<int>& local, std::vector<int>& local_edge) const {
+  const int n = vertices.size();
+  // 部分グラフの半辺 (頂点ごとに偏角順に並べた位置を番号とする)
+  for(int i = 0; i < n; ++i) local[vertices[i]] = i;
+  std::vector<int> start(n + 1), global;
+  for(int i = 0; i < n; ++i) {
+    for(auto h: rotation(vertices[i])) if(local[to(h)] != -1) local_edge[h] = global.size(), global.emplace_back(h);
+    start[i + 1] = global.size();
+  }
+  const int H = global.size();
+  std::vector<int> owner(H), head(H), mate(H), next(H);
+  for(int i = 0; i < n; ++i) for(int k = start[i]; k < start[i + 1]; ++k) owner[k] = i;
+  for(int k = 0; k < H; ++k) head[k] = local[to(global[k])], mate[k] = local_edge[twin(global[k])];
+  for(int k = 0; k < H; ++k) next[k] = mate[k] == start[head[k]] ? start[head[k] + 1] - 1 : mate[k] - 1;
+  for(auto h: global) local_edge[h] = -1;
+  for(auto v: vertices) local[v] = -1;
+
+  // 連結成分 (BFS なので各成分の先頭からの層も求まる)
+  std::vector<int> component(n, -1), depth(n), parent(n, -1), order, component_start = {0};   // parent: 親から来た半辺
+  for(int s = 0; s < n; ++s) {
+    if(component[s] != -1) continue;
+    int c = component_start.size() - 1;
+    component[s] = c;
+    order.emplace_back(s);
+    for(std::size_t i = component_start[c]; i < order.size(); ++i) {
+      int v = order[i];
+      for(int k = start[v]; k < start[v + 1]; ++k) {
+        int w = head[k];
+        if(component[w] == -1) component[w] = c, depth[w] = depth[v] + 1, parent[w] = k, order.emplace_back(w);
+      }
+    }
+    component_start.emplace_back(order.size());
+  }
+  int big = -1;
+  for(int c = 0; c + 1 < (int)component_start.size(); ++c) {
+    if(2 * n < 3 * (component_start[c + 1] - component_start[c])) big = c;
+  }
+
+  std::vector<bool> in_separator(n);
+  if(big != -1) {
+    const int K = component_start[big + 1] - component_start[big];
+    const int root = order[component_start[big]];
+    // BFS の層
+    int D = depth[order[component_start[big + 1] - 1]];
+    std::vector<int> level(D + 2);
+    for(int i = component_start[big]; i < component_start[big + 1]; ++i) ++level[depth[order[i]] + 1];
+    // 両側が空でない層を優先する (r-division で piece が小さくならないのを防ぐ)
+    int best = -1, below = 0;
+    auto rank = [&](int l, int below) {return std::make_pair(below == 0 || below + level[l + 1] == K, level[l + 1]);};
+    for(int l = 0, b = 0; l <= D; ++l) {
+      int above = K - b - level[l + 1];
+      if(3 * std::max(b, above) <= 2 * K && (best == -1 || rank(l, b) < rank(best, below))) best = l, below = b;
+      b += level[l + 1];
+    }
+    int size = rank(best, below).first ? K : level[best + 1];
+
+    // 面を三角形に分割する
+    std::vector<int> face(H, -1), triangle(H);
+    std::vector<int> vertex_depth(depth), vertex_parent(n, -1), anchor;   // 仮想の頂点は n 以降
+    struct Arc {int a, b, u, v;};                                          // 三角形 a, b の間の, 木に含まれない辺 u - v
+    std::vector<Arc> arcs;
+    for(int v = 0; v < n; ++v) if(parent[v] != -1) vertex_parent[v] = owner[parent[v]];
+    int T = 0;
+    std::vector<int> walk;
+    for(int i = component_start[big]; i < component_start[big + 1]; ++i) {
+      for(int h = start[order[i]]; h < start[order[i] + 1]; ++h) {
+        if(face[h] != -1) continue;
+        walk.clear();
+        for(int g = h; face[g] == -1; g = next[g]) face[g] = 1, walk.emplace_back(g);
+        const int L = walk.size();
+        if(L == 3) {
+          for(auto g: walk) triangle[g] = T;
+          ++T;
+          continue;
+        }
+        int c = vertex_depth.size(), j = 0;
+        for(int i = 0; i < L; ++i) {
+          triangle[walk[i]] = T + i;
+          if(depth[owner[walk[i]]] < depth[owner[walk[j]]]) j = i;
+        }
+        vertex_depth.emplace_back(depth[owner[walk[j]]] + 1);
+        vertex_parent.emplace_back(owner[walk[j]]);
+        anchor.emplace_back(T);
+        for(int i = 0; i < L; ++i) if(i != j) arcs.push_back({T + (i + L - 1) % L, T + i, c, owner[walk[i]]});
+        T += L;
+      }
+    }
+    for(int i = component_start[big]; i < component_start[big + 1]; ++i) {
+      for(int k = start[order[i]]; k < start[order[i] + 1]; ++k) {
+        if(mate[k] < k || parent[head[k]] == k || parent[owner[k]] == mate[k]) continue;
+        arcs.push_back({triangle[k], triangle[mate[k]], owner[k], head[k]});
+      }
+    }
+
+    // 双対木 (三角形 0 を根とする DFS の順)
+    if((int)arcs.size() == T - 1) {
+      std::vector<int> arc_start(T + 1), adjacent(2 * arcs.size());
+      for(const auto& e: arcs) ++arc_start[e.a + 1], ++arc_start[e.b + 1];
+      for(int t = 0; t < T; ++t) arc_start[t + 1] += arc_start[t];
+      {
+        auto pos = arc_start;
+        for(int k = 0; k < (int)arcs.size(); ++k) adjacent[pos[arcs[k].a]++] = k, adjacent[pos[arcs[k].b]++] = k;
+      }
+      std::vector<int> pre(T, -1), up(T, -1), sequence, stack = {0};   // up: 親へ向かう弧
+      while(!stack.empty()) {
+        int t = stack.back();
+        stack.pop_back();
+        pre[t] = sequence.size();
+        sequence.emplace_back(t);
+        for(int i = arc_start[t]; i < arc_start[t + 1]; ++i) {
+          const auto& e = arcs[adjacent[i]];
+          int s = e.a == t ? e.b : e.a;
+          if(pre[s] == -1 && s != 0 && up[s] == -1) up[s] = adjacent[i], stack.emplace_back(s);
+        }
+      }
+      if((int)sequence.size() == T) {
+        std::vector<int> sub(T, 1), virtuals(T);
+        for(auto a: anchor) ++virtuals[a];
+        for(int i = T - 1; 0 < i; --i) {
+          int t = sequence[i], e = up[t], s = arcs[e].a == t ? arcs[e].b : arcs[e].a;
+          sub[s] += sub[t], virtuals[s] += virtuals[t];
+        }
+        // 各弧の両端の LCA (Tarjan のオフライン法)
+        const int N = vertex_depth.size();
+        std::vector<int> child_start(N + 1), child(N), query_start(N + 1), query(2 * T), lca(T, -1);
+        for(int v = 0; v < N; ++v) if(vertex_parent[v] != -1) ++child_start[vertex_parent[v] + 1];
+        for(int t = 1; t < T; ++t) ++query_start[arcs[up[t]].u + 1], ++query_start[arcs[up[t]].v + 1];
+        for(int v = 0; v < N; ++v) child_start[v + 1] += child_start[v], query_start[v + 1] += query_start[v];
+        {
+          auto pos = child_start, qpos = query_start;
+          for(int v = 0; v < N; ++v) if(vertex_parent[v] != -1) child[pos[vertex_parent[v]]++] = v;
+          for(int t = 1; t < T; ++t) query[qpos[arcs[up[t]].u]++] = t, query[qpos[arcs[up[t]].v]++] = t;
+        }
+        std::vector<int> uf(N), ancestor(N), iterator(child_start.begin(), child_start.end() - 1);
+        std::vector<bool> finished(N);
+        for(int v = 0; v < N; ++v) uf[v] = ancestor[v] = v;
+        auto find = [&](int x) {
+          while(uf[x] != x) x = uf[x] = uf[uf[x]];
+          return x;
+        };
+        stack = {root};
+        while(!stack.empty()) {
+          int v = stack.back();
+          if(iterator[v] < child_start[v + 1]) {
+            stack.emplace_back(child[iterator[v]++]);
+            continue;
+          }
+          stack.pop_back();
+          finished[v] = true;
+          for(int i = query_start[v]; i < query_start[v + 1]; ++i) {
+            int t = query[i], w = arcs[up[t]].u == v ? arcs[up[t]].v : arcs[up[t]].u;
+            if(finished[w]) lca[t] = ancestor[find(w)];
+          }
+          if(!stack.empty()) {
+            int p = stack.back();
+            uf[find(v)] = find(p);
+            ancestor[find(p)] = p;
+          }
+        }
+        // 釣り合う基本閉路のうち, 実在する頂点が最も少ないもの
+        int chosen = -1;
+        for(int t = 1; t < T; ++t) {
+          const auto& e = arcs[up[t]];
+          int length = vertex_depth[e.u] + vertex_depth[e.v] - 2 * vertex_depth[lca[t]] + 1;
+          int inside = (sub[t] - length + 2) / 2 - virtuals[t], cycle = length;
+          for(int x: {e.u, e.v}) {
+            if(x < n) continue;
+            --cycle;
+            if(pre[t] <= pre[anchor[x - n]] && pre[anchor[x - n]] < pre[t] + sub[t]) ++inside;
+          }
+          int outside = K - inside - cycle;
+          if(0 < inside && 0 < outside && 3 * std::max(inside, outside) <= 2 * K && cycle < size) size = cycle, chosen = t;
+        }
+        if(chosen != -1) {
+          const auto& e = arcs[up[chosen]];
+          for(int x: {e.u, e.v}) for(; x != lca[chosen]; x = vertex_parent[x]) if(x < n) in_separator[x] = true;
+          if(lca[chosen] < n) in_separator[lca[chosen]] = true;
+          best = -1;
+        }
+      }
+    }
+    if(best != -1) for(int i = component_start[big]; i < component_start[big + 1]; ++i) if(depth[order[i]] == best) in_separator[order[i]] = true;
+  }
+
+  // S を除いた連結成分を A, B に分ける
+  Separator result;
+  std::vector<std::vector<int>> parts;
+  std::vector<bool> visited(in_separator);
+  for(int s = 0; s < n; ++s) {
+    if(in_separator[s]) result.S.emplace_back(vertices[s]);
+    if(visited[s]) continue;
+    visited[s] = true;
+    std::vector<int> part = {s};
+    for(std::size_t i = 0; i < part.size(); ++i) {
+      for(int k = start[part[i]]; k < start[part[i] + 1]; ++k) if(!visited[head[k]]) visited[head[k]] = true, part.emplace_back(head[k]);
+    }
+    parts.emplace_back(std::move(part));
+  }
+  std::stable_sort(std::begin(parts), std::end(parts), [](const auto& a, const auto& b) {return a.size() > b.size();});
+  for(const auto& part: parts) {
+    auto& side = result.A.size() <= result.B.size() ? result.A : result.B;
+    for(auto v: part) side.emplace_back(vertices[v]);
+  }
+  return result;
+}
+
+PlaneGraph::Division PlaneGraph::division(int r) const {
+  assert(2 <= r);
+  std::vector<int> local(size(), -1), local_edge(to_.size(), -1), count(size());
+  std::vector<bool> inside(size());
+  std::vector<std::vector<int>> stack(1, std::vector<int>(size()));
+  for(int v = 0; v < size(); ++v) stack[0][v] = v;
+  Division D;
+  D.start = {0};
+  while(!stack.empty()) {
+    auto P = std::move(stack.back());
+    stack.pop_back();
+    if(r < (int)P.size()) {
+      auto [A, B, S] = separate(P, local, local_edge);
+      if(!A.empty() && !B.empty()) {
+        A.insert(std::end(A), std::begin(S), std::end(S));
+        B.insert(std::end(B), std::begin(S), std::end(S));
+        stack.emplace_back(std::move(B));
+        stack.emplace_back(std::move(A));
+        continue;
+      }
+      // 次数最小の頂点 v を除いた piece と, v の星に分ける
+      for(auto v: P) inside[v] = true;
+      int v = -1, degree = size();
+      for(auto u: P) {
+        int d = 0;
+        for(auto h: rotation(u)) d += inside[to(h)];
+        if(d < degree) v = u, degree = d;
+      }
+      std::vector<int> star;
+      for(auto h: rotation(v)) if(inside[to(h)]) star.emplace_back(to(h));
+      for(auto u: P) inside[u] = false;
+      std::erase(P, v);
+      stack.emplace_back(std::move(P));
+      if(star.empty()) stack.push_back({v});
+      for(std::size_t i = 0; i < star.size(); i += r - 1) {
+        std::vector<int> Q{v};
+        Q.insert(std::end(Q), std::begin(star) + i, std::begin(star) + std::min(star.size(), i + r - 1));
+        stack.emplace_back(std::move(Q));
+      }
+      continue;
+    }
+    for(auto v: P) D.vertex.emplace_back(v), ++count[v];
+    D.start.emplace_back(D.vertex.size());
+  }
+  D.boundary.resize(D.vertex.size());
+  for(std::size_t k = 0; k < D.vertex.size(); ++k) D.boundary[k] = 1 < count[D.vertex[k]];
+  return D;
+}
+
+PlaneGraph::Cut PlaneGraph::minimum_cut(int s, int t, const std::vector<long long>& capacity) const {
+  constexpr long long INF = std::numeric_limits<long long>::max();
+  using Item = std::pair<long long, int>;
+  const int n = size(), H = to_.size(), F = faces();
+  assert(s != t && (int)capacity.size() == H);
+  Cut C{0, {}, {}};
+  // s, t をともに境界に含む面
+  int a = -1, b = -1;
+  {
+    std::vector<int> mark(F, -1);
+    for(auto h: rotation(s)) mark[face_[h]] = h;
+    for(auto h: rotation(t)) if(mark[face_[h]] != -1) {a = mark[face_[h]], b = h; break;}
+  }
+  if(a != -1) {
+    // 面 f の境界のうち t から s へ向かう部分を新しい面 F とする
+    const int f = face_[a];
+    std::vector<bool> lower(H);
+    for(int h = b; h != a; h = next_[h]) lower[h] = true;
+    auto node = [&](int h) {return lower[h] ? F : face_[h];};
+    std::vector<long long> d(F + 1, INF);
+    std::vector<int> parent(F + 1, -1);
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> q;
+    q.emplace(d[f] = 0, f);
+    while(!q.empty()) {
+      auto [dx, x] = q.top();
+      q.pop();
+      if(x == F) break;
+      if(d[x] < dx) continue;
+      for(auto h: boundary(x == F ? f : x)) {
+        int y = node(twin(h));
+        if(node(h) != x || d[y] <= dx + capacity[h]) continue;
+        parent[y] = h;
+        q.emplace(d[y] = dx + capacity[h], y);
+      }
+    }
+    C.value = d[F];
+    for(int x = F; x != f; x = node(parent[x])) C.edges.emplace_back(parent[x]);
+    // 最短路長で打ち切った距離をポテンシャルとする (確定していない面の距離は d[F] 以上)
+    for(auto& dx: d) dx = std::min(dx, C.value);
+    C.flow.resize(H);
+    for(int h = 0; h < H; ++h) C.flow[h] = d[node(twin(h))] - d[node(h)];
+    return C;
+  }
+  // 辺数が最小の s-t 経路 P (Dijkstra の回数を抑える)
+  std::vector<int> parent(n, -1), queue{s};
+  parent[s] = H;
+  for(std::size_t i = 0; i < queue.size() && parent[t] == -1; ++i) {
+    for(auto h: rotation(queue[i])) if(parent[to(h)] == -1) parent[to(h)] = h, queue.emplace_back(to(h));
+  }
+  // 連結成分が異なれば流量は 0
+  if(parent[t] == -1) return C;
+  // 双対グラフの閉路は向きを区別しないので, 容量が向きによって異なれば一般の最大流で求める
+  for(int h = 0; h < H; ++h) if(capacity[h] != capacity[twin(h)]) return dinic(s, t, capacity);
+  std::vector<bool> crossing(H / 2);
+  std::vector<int> sources;
+  for(int v = t; v != s; v = from(parent[v])) crossing[parent[v] / 2] = true, sources.emplace_back(face_[parent[v]]);
+  // 頂点 2x + p は (面 x, P と交わった回数の偶奇 p), 触った頂点だけ戻す
+  std::vector<long long> d(2 * F, INF);
+  std::vector<int> via(2 * F, -1), touched;
+  std::vector<bool> odd(H / 2), started(F);
+  long long best = INF;
+  for(auto f: sources) {
+    if(started[f]) continue;
+    started[f] = true;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> q;
+    q.emplace(d[2 * f] = 0, 2 * f);
+    touched.emplace_back(2 * f);
+    while(!q.empty()) {
+      auto [dx, x] = q.top();
+      q.pop();
+      if(best <= dx) break;
+      if(d[x] < dx) continue;
+      if(x == 2 * f + 1) {
+        // 閉路で奇数回通った辺を除くと s と t は分かれる
+        best = dx;
+        std::fill(std::begin(odd), std::end(odd), false);
+        for(int y = x; y != 2 * f; y = 2 * face_[via[y]] + ((y & 1) ^ crossing[via[y] / 2])) odd[via[y] / 2] = !odd[via[y] / 2];
+        break;
+      }
+      for(auto h: boundary(x / 2)) {
+        int y = 2 * face_[twin(h)] + ((x & 1) ^ crossing[h / 2]);
+        if(d[y] <= dx + capacity[h]) continue;
+        if(d[y] == INF) touched.emplace_back(y);
+        via[y] = h;
+        q.emplace(d[y] = dx + capacity[h], y);
+      }
+    }
+    for(auto x: touched) d[x] = INF;
+    touched.clear();
+  }
+  // s 側の頂点から出る辺がカット
+  std::vector<bool> side(n);
+  queue = {s};
+  side[s] = true;
+  for(std::size_t i = 0; i < queue.size(); ++i) {
+    for(auto h: rotation(queue[i])) if(!odd[h / 2] && !side[to(h)]) side[to(h)] = true, queue.emplace_back(to(h));
+  }
+  assert(!side[t]);
+  for(auto v: queue) for(auto h: rotation(v)) if(!side[to(h)]) C.edges.emplace_back(h), C.value += capacity[h];
+  assert(C.value == best);
+  return C;
+}
+
+// 半辺 h を容量 capacity[h] の弧とした Dinic (twin(h) が逆辺), 再帰しない
+PlaneGraph::Cut PlaneGraph::dinic(int s, int t, const std::vector<long long>& capacity) const {
+  constexpr long long INF = std::numeric_limits<long long>::max();
+  const int n = size(), H = to_.size();
+  Cut C{0, {}, std::vector<long long>(H, 0)};
+  auto& flow = C.flow;
+  std::vector<int> level(n), current(n), queue, path;
+  auto bfs = [&]() {
+    std::fill(std::begin(level), std::end(level), -1);
+    level[s] = 0;
+    queue = {s};
+    for(std::size_t i = 0; i < queue.size(); ++i) {
+      for(auto h: rotation(queue[i])) if(flow[h] < capacity[h] && level[to(h)] == -1) level[to(h)] = level[queue[i]] + 1, queue.emplace_back(to(h));
+    }
+    return level[t] != -1;
+  };
+  while(bfs()) {
+    std::copy(std::begin(vertex_start_), std::end(vertex_start_) - 1, std::begin(current));
+    path.clear();
+    for(int v = s; ; ) {
+      if(v == t) {
+        long long push = INF;
+        for(auto h: path) push = std::min(push, capacity[h] - flow[h]);
+        for(auto h: path) flow[h] += push, flow[twin(h)] -= push;
+        path.clear();
+        v = s;
+        continue;
+      }
+      // 同じ層の先へ進めなければ, v を行き止まりとして 1 つ戻る
+      auto& i = current[v];
+      while(i < vertex_start_[v + 1] && (capacity[rotation_[i]] <= flow[rotation_[i]] || level[to(rotation_[i])] != level[v] + 1)) ++i;
+      if(i < vertex_start_[v + 1]) {
+        path.emplace_back(rotation_[i]);
+        v = to(rotation_[i]);
+      } else if(v == s) {
+        break;
+      } else {
+        v = from(path.back());
+        path.pop_back();
+        ++current[v];
+      }
+    }
+  }
+  // 残余グラフで s から行ける頂点が s 側
+  for(auto v: queue) for(auto h: rotation(v)) if(level[to(h)] == -1) C.edges.emplace_back(h), C.value += capacity[h];
+  return C;
+}
+
+void PlaneGraph::debug() const {
+  std::cout << "*Vertices*" << std::endl;
+  for(int v = 0; v < size(); ++v) std::cout << v << ": (" << point_[v].x << ", " << point_[v].y << ")" << std::endl;
+  std::cout << "*Half edges*" << std::endl;
+  for(int h = 0; h < (int)to_.size(); ++h) std::cout << h << ": " << from(h) << " to " << to(h) << ", next = " << next(h) << ", face = " << face(h) << std::endl;
+  std::cout << "*Faces*" << std::endl;
+  for(int f = 0; f < faces(); ++f) {
+    std::cout << f << (outer(f) ? " (outer):" : ":");
+    for(auto h: boundary(f)) std::cout << " " << from(h);
+    std::cout << std::endl;
+  }
+}
+
+class PointLocation {
+ public:
+  PointLocation(const PlaneGraph&);
+  int locate(const Point&) const;
+  std::vector<int> locate(const std::vector<Point>&, int threads = 1) const;
+ private:
+  struct Node {int segment, left, right;};
+  const PlaneGraph& G_;
+  std::vector<int> segment_face_;       // 辺 (左から右へ向けた半辺) の上側の面
+  std::vector<int> segment_under_;      // 辺の下側の面
+  std::vector<Point> p_, q_;            // 辺の左端, 右端
+  std::vector<std::uint64_t> priority_;
+  std::vector<Node> node_;              // 0 番は空
+  std::vector<long long> xs_;           // 帯の左端の x 座標
+  std::vector<int> root_;               // 帯 [xs_[i], xs_[i + 1]) の木
+  bool below(int a, int b, long long x, int side) const;
+  int copy(int t) {
+    node_.emplace_back(node_[t]);
+    return node_.size() - 1;
+  }
+  int merge(int a, int b);
+  std::pair<int, int> split(int t, int s, long long x);
+  int erase(int t, int s, long long x);
+};
+
+// 辺 a が x + side ε で辺 b より下にあるか
+bool PointLocation::below(int a, int b, long long x, int side) const {
+  // y_a(x) = (p.y (q.x - p.x) + (q.y - p.y) (x - p.x)) / (q.x - p.x)
+  auto numerator = [&](int s) {return __int128(p_[s].y) * (q_[s].x - p_[s].x) + __int128(q_[s].y - p_[s].y) * (x - p_[s].x);};
+  auto l = numerator(a) * (q_[b].x - p_[b].x), r = numerator(b) * (q_[a].x - p_[a].x);
+  if(l != r) return l < r;
+  // x で交わるので傾きで比べる
+  auto sa = __int128(q_[a].y - p_[a].y) * (q_[b].x - p_[b].x), sb = __int128(q_[b].y - p_[b].y) * (q_[a].x - p_[a].x);
+  return 0 < side ? sa < sb : sb < sa;
+}
+
+int PointLocation::merge(int a, int b) {
+  if(!a || !b) return a | b;
+  if(priority_[node_[b].segment] < priority_[node_[a].segment]) {
+    auto c = copy(a);
+    auto r = merge(node_[a].right, b);
+    node_[c].right = r;
+    return c;
+  }
+  auto c = copy(b);
+  auto l = merge(a, node_[b].left);
+  node_[c].left = l;
+  return c;
+}
+
+// x + ε で辺 s より下の辺と, それ以外に分ける
+std::pair<int, int> PointLocation::split(int t, int s, long long x) {
+  if(!t) return {0, 0};
+  auto c = copy(t);
+  if(below(node_[t].segment, s, x, 1)) {
+    auto [l, r] = split(node_[t].right, s, x);
+    node_[c].right = l;
+    return {c, r};
+  }
+  auto [l, r] = split(node_[t].left, s, x);
+  node_[c].left = r;
+  return {l, c};
+}
+
+// x - ε での順序で辺 s を探して除く
+int PointLocation::erase(int t, int s, long long x) {
+  if(node_[t].segment == s) return merge(node_[t].left, node_[t].right);
+  auto c = copy(t);
+  if(below(s, node_[t].segment, x, -1)) {
+    auto l = erase(node_[t].left, s, x);
+    node_[c].left = l;
+  } else {
+    auto r = erase(node_[t].right, s, x);
+    node_[c].right = r;
+  }
+  return c;
+}
+
+PointLocation::PointLocation(const PlaneGraph& G) : G_(G), node_(1, {-1, 0, 0}) {
+  // 垂直でない辺を左から右へ向ける
+  struct Event {long long x; int type, segment;};   // type: 0 なら除く, 1 なら加える
+  std::vector<Event> events;
+  for(int k = 0; k < G.edges(); ++k) {
+    int h = 2 * k;
+    auto a = G.point(G.from(h)), b = G.point(G.to(h));
+    if(a.x == b.x) continue;
+    if(b.x < a.x) h ^= 1, std::swap(a, b);
+    int s = p_.size();
+    p_.emplace_back(a);
+    q_.emplace_back(b);
+    segment_face_.emplace_back(G.face(h));
+    segment_under_.emplace_back(G.face(PlaneGraph::twin(h)));
+    std::uint64_t z = s + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    priority_.emplace_back(z ^ (z >> 31));
+    events.push_back({a.x, 1, s});
+    events.push_back({b.x, 0, s});
+  }
+  std::sort(std::begin(events), std::end(events), [](const auto& a, const auto& b) {return a.x != b.x ? a.x < b.x : a.type < b.type;});
+  int root = 0;
+  for(std::size_t i = 0; i < events.size(); ) {
+    auto x = events[i].x;
+    for(; i < events.size() && events[i].x == x; ++i) {
+      auto s = events[i].segment;
+      if(events[i].type == 0) {
+        root = erase(root, s, x);
+      } else {
+        auto [l, r] = split(root, s, x);
+        node_.push_back({s, 0, 0});
+        int m = merge(l, node_.size() - 1);
+        root = merge(m, r);
+      }
+    }
+    xs_.emplace_back(x);
+    root_.emplace_back(root);
+  }
+}
+
+int PointLocation::locate(const Point& p) const {
+  int i = std::upper_bound(std::begin(xs_), std::end(xs_), p.x) - std::begin(xs_) - 1;
+  if(i < 0) return -1;
+  // 下で最も上の辺と, 上で最も下の辺
+  int below = -1, above = -1;
+  for(int t = root_[i]; t; ) {
+    auto s = node_[t].segment;
+    auto cross = __int128(q_[s].x - p_[s].x) * (p.y - p_[s].y) - __int128(q_[s].y - p_[s].y) * (p.x - p_[s].x);
+    if(0 <= cross) below = s, t = node_[t].right;
+    else above = s, t = node_[t].left;
+  }
+  if(below != -1) return segment_face_[below];
+  if(above != -1) return segment_under_[above];
+  return -1;
+}
+
+std::vector<int> PointLocation::locate(const std::vector<Point>& points, int threads) const {
+  const int m = points.size();
+  std::vector<int> order(m), result(m);
+  std::iota(std::begin(order), std::end(order), 0);
+  std::sort(std::begin(order), std::end(order), [&](int a, int b) {return points[a].x != points[b].x ? points[a].x < points[b].x : points[a].y < points[b].y;});
+  threads = std::max(1, std::min(threads, m));
+  auto run = [&](int k) {
+    for(int i = (long long)m * k / threads; i < (long long)m * (k + 1) / threads; ++i) result[order[i]] = locate(points[order[i]]);
+  };
+  if(threads == 1) {
+    run(0);
+  } else {
+    std::vector<std::thread> pool;
+    for(int k = 0; k < threads; ++k) pool.emplace_back(run, k);
+    for(auto& t: pool) t.join();
+  }
+  return result;
+}
+
 #include<bits/stdc++.h>
 using namespace std;
 int main() {
+  /*
+  // ベンチマーク (1 コア, k * k の格子に対角線を加えた三角形分割: k = 1826 で辺数 10^7)
+  //   build 1030ms, dualgraph 259ms
+  {
+    int k = 1826;
+    PlaneGraph G;
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) G.insert({i, j});
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) {
+      if(i + 1 < k) G.insert(i * k + j, (i + 1) * k + j);
+      if(j + 1 < k) G.insert(i * k + j, i * k + j + 1);
+      if(i + 1 < k && j + 1 < k) G.insert(i * k + j, (i + 1) * k + j + 1);
+    }
+    auto start = chrono::steady_clock::now();
+    G.build();
+    auto middle = chrono::steady_clock::now();
+    auto D = G.dualgraph();
+    auto end = chrono::steady_clock::now();
+    cout << G.edges() << " edges, " << G.faces() << " faces: build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, dualgraph " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  // separator, division (k = 1000 で頂点数 10^6)
+  //   separator 1150ms (|S| = 1000, |A| = 666253, |B| = 332747), division(1000) 7640ms (1621 個の piece)
+  {
+    int k = 1000;
+    PlaneGraph G;
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) G.insert({i, j});
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) {
+      if(i + 1 < k) G.insert(i * k + j, (i + 1) * k + j);
+      if(j + 1 < k) G.insert(i * k + j, i * k + j + 1);
+      if(i + 1 < k && j + 1 < k) G.insert(i * k + j, (i + 1) * k + j + 1);
+    }
+    G.build();
+    vector<int> all(k * k);
+    iota(begin(all), end(all), 0);
+    auto start = chrono::steady_clock::now();
+    auto S = G.separator(all).S;
+    auto middle = chrono::steady_clock::now();
+    auto D = G.division(1000);
+    auto end = chrono::steady_clock::now();
+    cout << "separator " << S.size() << " " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, division " << D.start.size() - 1 << " " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  // PointLocation (k = 578 で辺数 10^6, 一様乱数の 10^6 点)
+  //   構築 1400ms, 1 点ずつ 2590ms, locate(points) 750ms (x 座標でソートするとキャッシュに載りやすい)
+  {
+    int k = 578;
+    PlaneGraph G;
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) G.insert({i, j});
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) {
+      if(i + 1 < k) G.insert(i * k + j, (i + 1) * k + j);
+      if(j + 1 < k) G.insert(i * k + j, i * k + j + 1);
+      if(i + 1 < k && j + 1 < k) G.insert(i * k + j, (i + 1) * k + j + 1);
+    }
+    G.build();
+    auto start = chrono::steady_clock::now();
+    PointLocation L(G);
+    auto middle = chrono::steady_clock::now();
+    mt19937 rng(1);
+    vector<Point> points(1000000);
+    for(auto& p: points) p = {(long long)(rng() % k), (long long)(rng() % k)};
+    auto faces = L.locate(points);
+    auto end = chrono::steady_clock::now();
+    cout << "build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, locate " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  // minimum_cut (k = 1000 で頂点数 10^6, 縦の辺の容量を 10^9, それ以外を 1 以上 1000 以下の乱数にして, カットが格子を横切るようにする)
+  //   左端と右端の中央 (同じ面, 向きで容量が異なる): 1176ms (カットの辺数 1999)
+  //                                                  FlowNetwork::maximum_flow (Dinic) は 10 分以上
+  //   中央付近の 20 離れた 2 頂点 (容量は向きによらない): 66400ms (|P| = 20 回の Dijkstra)
+  {
+    int k = 1000;
+    PlaneGraph G;
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) G.insert({i, j});
+    for(int i = 0; i < k; ++i) for(int j = 0; j < k; ++j) {
+      if(i + 1 < k) G.insert(i * k + j, (i + 1) * k + j);
+      if(j + 1 < k) G.insert(i * k + j, i * k + j + 1);
+      if(i + 1 < k && j + 1 < k) G.insert(i * k + j, (i + 1) * k + j + 1);
+    }
+    G.build();
+    mt19937 rng(1);
+    vector<long long> capacity(2 * G.edges());
+    for(int h = 0; h < 2 * G.edges(); ++h) capacity[h] = abs(G.to(h) - G.from(h)) == k ? 1000000000 : rng() % 1000 + 1;
+    auto start = chrono::steady_clock::now();
+    auto C = G.minimum_cut(k / 2 * k, k / 2 * k + k - 1, capacity);
+    auto middle = chrono::steady_clock::now();
+    for(int e = 0; e < G.edges(); ++e) capacity[2 * e + 1] = capacity[2 * e];
+    auto D = G.minimum_cut(k / 2 * k + k / 2, k / 2 * k + k / 2 + 20, capacity);
+    auto end = chrono::steady_clock::now();
+    cout << C.value << " " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, " << D.value << " " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  */
+
   PlaneGraph G;
   G.insert({0, 0});
-  G.insert({1, 0});
-  G.insert({1, 1});
-  G.insert({1, 2});
   G.insert({2, 0});
+  G.insert({2, 2});
+  G.insert({2, 4});
+  G.insert({4, 0});
   G.insert(0, 1);
   G.insert(0, 2);
   G.insert(0, 3);
   G.insert(1, 4);
   G.insert(2, 4);
   G.insert(3, 4);
-  auto H = G.dualgraph();
+  G.build();
   G.debug();
-  cout<<endl<<"-------- dualgraph --------"<<endl<<endl;
-  H.debug();
+  cout << endl << "-------- dualgraph --------" << endl << endl;
+  auto D = G.dualgraph();
+  for(int f = 0; f < G.faces(); ++f) {
+    cout << f << ":";
+    for(int k = D.start[f]; k < D.start[f + 1]; ++k) cout << " " << D.to[k];
+    cout << endl;
+  }
+  cout << endl << "-------- separator --------" << endl << endl;
+  auto [A, B, S] = G.separator({0, 1, 2, 3, 4});
+  for(const auto& X: {A, B, S}) {
+    for(auto v: X) cout << v << " ";
+    cout << endl;
+  }
+  cout << endl << "-------- point location --------" << endl << endl;
+  PointLocation L(G);
+  for(auto f: L.locate({{2, 1}, {2, 3}, {1, 3}, {2, -1}, {5, 1}}, 2)) cout << f << endl;
+  cout << endl << "-------- minimum cut --------" << endl << endl;
+  // 辺 k の容量を k + 1 とし, 逆向きは 0 とする
+  vector<long long> capacity(2 * G.edges());
+  for(int e = 0; e < G.edges(); ++e) capacity[2 * e] = e + 1;
+  auto C = G.minimum_cut(0, 4, capacity);
+  cout << "value " << C.value << ", edges:";
+  for(auto h: C.edges) cout << " " << G.from(h) << "-" << G.to(h);
+  cout << endl << "flow:";
+  for(int h = 0; h < 2 * G.edges(); h += 2) cout << " " << C.flow[h];
+  cout << endl;
 }
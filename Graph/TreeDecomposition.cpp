@@ -0,0 +1,318 @@
+// 隣接リストで表現された無向グラフの木分解と, 木分解上の DP
+
+// 辺は両方向に追加しておくこと (Graph.cpp と同じ表現)
+// 木分解: 消去順序の発見的解法 O(|V| w^2 log |V|) 程度 (w は幅)
+//   解説: https://en.wikipedia.org/wiki/Tree_decomposition
+//   残っている頂点のうちスコア最小の頂点 v を消去し, v の隣接頂点どうしをすべて結ぶことを繰り返す
+//     MinDegree: スコアは次数
+//     MinFill:   スコアは消去で新たに張られる辺の本数 (同じなら次数の小さい方)
+//                新たな辺を張らない消去 (単体的頂点) では隣接頂点のスコアを差分で更新する
+//                次数が limit を超える頂点のスコアは数えずに最大としておく (密なグラフで打ち切りを速くする)
+//   v の bag は {v} ∪ (消去時の隣接頂点) で, 親は隣接頂点のうち最初に消去される頂点
+//   幅が limit を超えたら打ち切る (width() は limit + 1 を返し, 木分解は作らない)
+// nice な木分解
+//   節点は Leaf (bag は空), Introduce (子の bag に v を加える), Forget (子の bag から v を除く),
+//   Join (2 つの子と同じ bag) の 4 種類で, 子は親より前に並び, 最後の節点 (根) の bag は空
+//   各節点の bag は昇順に並べて 1 本の配列に詰めて持つ
+// DP: O(|V| w 2^w)
+//   各節点で bag の部分集合 (bitmask) ごとの最大重みを, 長さ 2^|bag| の配列に持つ
+//   配列は親で使い終わったら解放する
+//   復元のため Forget 節点では v を採用した方が大きかったかを記録しておき, 根から bitmask をたどる
+//   最小 (重み) 頂点被覆は最大 (重み) 独立集合の補集合
+//   自己ループのある頂点は独立集合に含めない
+//   重みは非負とする
+
+#include<algorithm>
+#include<bit>
+#include<cassert>
+#include<cstdint>
+#include<functional>
+#include<limits>
+#include<queue>
+#include<utility>
+#include<vector>
+
+using Weight = long long;
+using Vertex = int;
+struct Edge {Vertex from, to; Weight weight;};
+using Graph = std::vector<std::vector<Edge>>;
+
+class TreeDecomposition {
+ public:
+  enum class Heuristic {MinDegree, MinFill};
+  enum Type {Leaf, Introduce, Forget, Join};
+  struct Node {Type type; Vertex v; int left, right;};   // Introduce, Forget は left だけ, Join は left と right を使う
+  static constexpr int MAX_BAG = 25;                      // DP できる bag の大きさの上限
+  TreeDecomposition(const Graph&, Heuristic = Heuristic::MinFill, int limit = std::numeric_limits<int>::max());
+  int width() const {return width_;}
+  const std::vector<Node>& nodes() const {return nice_;}
+  std::vector<Vertex> bag(int k) const {return {std::begin(bags_) + start_[k], std::begin(bags_) + start_[k + 1]};}
+  std::vector<Vertex> maximum_weight_independent_set(const std::vector<Weight>&) const;
+  std::vector<Vertex> maximum_independent_set() const {return maximum_weight_independent_set(std::vector<Weight>(n_, 1));}
+  std::vector<Vertex> minimum_weight_vertex_cover(const std::vector<Weight>&) const;
+  std::vector<Vertex> minimum_vertex_cover() const {return minimum_weight_vertex_cover(std::vector<Weight>(n_, 1));}
+ private:
+  int n_, width_ = -1;
+  std::vector<std::vector<Vertex>> adj_;   // 昇順, 自己ループと多重辺は除く
+  std::vector<bool> loop_;
+  std::vector<Node> nice_;
+  std::vector<int> start_;                 // 節点 k の bag は bags_[start_[k]], ..., bags_[start_[k + 1] - 1]
+  std::vector<Vertex> bags_;
+  bool adjacent(Vertex u, Vertex v) const {return std::binary_search(std::begin(adj_[u]), std::end(adj_[u]), v);}
+  int add(Type type, Vertex v, int left, int right = -1);
+};
+
+// 昇順の A, B について A ∪ B から x, y を除いたもの
+static std::vector<Vertex> merge(const std::vector<Vertex>& A, const std::vector<Vertex>& B, Vertex x, Vertex y) {
+  std::vector<Vertex> result;
+  result.reserve(A.size() + B.size());
+  std::set_union(std::begin(A), std::end(A), std::begin(B), std::end(B), std::back_inserter(result));
+  result.erase(std::remove_if(std::begin(result), std::end(result), [&](Vertex u) {return u == x || u == y;}), std::end(result));
+  return result;
+}
+
+// bitmask の p bit 目を除く / p bit 目に b を挟む
+static std::uint32_t erase_bit(std::uint32_t m, int p) {return (m & ((1u << p) - 1)) | (m >> (p + 1) << p);}
+static std::uint32_t insert_bit(std::uint32_t m, int p, std::uint32_t b) {return (m & ((1u << p) - 1)) | b << p | (m >> p << (p + 1));}
+
+TreeDecomposition::TreeDecomposition(const Graph& G, Heuristic heuristic, int limit) : n_(G.size()), adj_(n_), loop_(n_) {
+  for(Vertex v = 0; v < n_; ++v) for(const auto& e: G[v]) {
+    if(e.to == v) loop_[v] = true;
+    else adj_[v].emplace_back(e.to), adj_[e.to].emplace_back(v);
+  }
+  for(auto& A: adj_) {
+    std::sort(std::begin(A), std::end(A));
+    A.erase(std::unique(std::begin(A), std::end(A)), std::end(A));
+  }
+
+  // 消去順序
+  auto H = adj_;                            // 消去途中のグラフ
+  std::vector<long long> fill(n_);
+  auto count = [&](Vertex v) {
+    if(limit < (int)H[v].size()) return -1ll;
+    long long c = 0;
+    for(std::size_t i = 0; i < H[v].size(); ++i) for(std::size_t j = i + 1; j < H[v].size(); ++j) {
+      if(!std::binary_search(std::begin(H[H[v][i]]), std::end(H[H[v][i]]), H[v][j])) ++c;
+    }
+    return c;
+  };
+  auto key = [&](Vertex v) {
+    if(heuristic == Heuristic::MinDegree) return (long long)H[v].size();
+    return fill[v] < 0 ? std::numeric_limits<long long>::max() : fill[v] * (n_ + 1) + (long long)H[v].size();
+  };
+  using Item = std::pair<long long, Vertex>;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> q;
+  for(Vertex v = 0; v < n_; ++v) {
+    if(heuristic == Heuristic::MinFill) fill[v] = count(v);
+    q.emplace(key(v), v);
+  }
+  std::vector<Vertex> order;
+  std::vector<int> position(n_, -1);
+  std::vector<std::vector<Vertex>> neighbor(n_);   // 消去時の隣接頂点
+  while(!q.empty()) {
+    auto [k, v] = q.top();
+    q.pop();
+    if(position[v] != -1 || k != key(v)) continue;
+    if(limit < (int)H[v].size()) {
+      width_ = limit + 1;
+      return;
+    }
+    width_ = std::max(width_, (int)H[v].size());
+    position[v] = order.size();
+    order.emplace_back(v);
+    const auto& N = H[v];
+    bool simplicial = heuristic == Heuristic::MinFill && fill[v] == 0;
+    for(auto u: N) {
+      if(simplicial && 0 <= fill[u]) fill[u] -= H[u].size() - N.size();
+      H[u] = merge(H[u], N, u, v);
+      if(simplicial && fill[u] < 0) fill[u] = count(u);
+    }
+    if(heuristic == Heuristic::MinFill && !simplicial) {
+      std::vector<Vertex> touched(std::begin(N), std::end(N));
+      for(auto u: N) touched.insert(std::end(touched), std::begin(H[u]), std::end(H[u]));
+      std::sort(std::begin(touched), std::end(touched));
+      touched.erase(std::unique(std::begin(touched), std::end(touched)), std::end(touched));
+      for(auto u: touched) if(u != v && position[u] == -1) fill[u] = count(u), q.emplace(key(u), u);
+    } else {
+      for(auto u: N) q.emplace(key(u), u);
+    }
+    neighbor[v] = std::move(H[v]);
+    H[v].clear();
+  }
+  width_ = std::max(width_, 0);
+
+  // nice な木分解 (消去順に作ると子が親より前に並ぶ)
+  std::vector<std::vector<Vertex>> children(n_);
+  std::vector<Vertex> roots;
+  std::vector<int> top(n_);
+  start_ = {0};
+  for(auto v: order) {
+    std::vector<Vertex> B = neighbor[v];
+    B.insert(std::lower_bound(std::begin(B), std::end(B), v), v);
+    int cur = -1;
+    for(auto c: children[v]) {
+      auto k = top[c];
+      for(auto x: bag(k)) if(!std::binary_search(std::begin(B), std::end(B), x)) k = add(Forget, x, k);
+      auto C = bag(k);
+      for(auto x: B) if(!std::binary_search(std::begin(C), std::end(C), x)) k = add(Introduce, x, k);
+      cur = cur == -1 ? k : add(Join, -1, cur, k);
+    }
+    if(cur == -1) {
+      cur = add(Leaf, -1, -1);
+      for(auto x: B) cur = add(Introduce, x, cur);
+    }
+    top[v] = cur;
+    Vertex parent = -1;
+    for(auto u: neighbor[v]) if(parent == -1 || position[u] < position[parent]) parent = u;
+    if(parent == -1) roots.emplace_back(v);
+    else children[parent].emplace_back(v);
+  }
+  int root = -1;
+  for(auto r: roots) {
+    auto k = top[r];
+    for(auto x: bag(k)) k = add(Forget, x, k);
+    root = root == -1 ? k : add(Join, -1, root, k);
+  }
+  if(root == -1) add(Leaf, -1, -1);
+}
+
+// 節点を加えて番号を返す (bag は子の bag から作る)
+int TreeDecomposition::add(Type type, Vertex v, int left, int right) {
+  std::vector<Vertex> B;
+  if(type != Leaf) B = bag(left);
+  if(type == Introduce) B.insert(std::lower_bound(std::begin(B), std::end(B), v), v);
+  if(type == Forget) B.erase(std::lower_bound(std::begin(B), std::end(B), v));
+  nice_.push_back({type, v, left, right});
+  bags_.insert(std::end(bags_), std::begin(B), std::end(B));
+  start_.emplace_back(bags_.size());
+  return nice_.size() - 1;
+}
+
+std::vector<Vertex> TreeDecomposition::maximum_weight_independent_set(const std::vector<Weight>& weight) const {
+  assert(!nice_.empty() && width_ < MAX_BAG);
+  const Weight NEG = std::numeric_limits<Weight>::min() / 4;
+  const int K = nice_.size();
+  std::vector<std::vector<Weight>> table(K);
+  std::vector<std::vector<bool>> taken(K);   // Forget 節点で v を採用した方が大きかったか
+  std::vector<Weight> sum;
+  for(int k = 0; k < K; ++k) {
+    const auto& [type, v, left, right] = nice_[k];
+    auto B = std::begin(bags_) + start_[k];
+    int s = start_[k + 1] - start_[k];
+    auto& T = table[k];
+    T.assign(std::size_t(1) << s, NEG);
+    if(type == Leaf) {
+      T[0] = 0;
+    } else if(type == Introduce) {
+      int p = std::lower_bound(B, B + s, v) - B;
+      std::uint32_t conflict = 0;
+      for(int i = 0; i < s; ++i) if(i != p && adjacent(v, B[i])) conflict |= 1u << i;
+      const auto& C = table[left];
+      for(std::uint32_t m = 0; m < T.size(); ++m) {
+        auto value = C[erase_bit(m, p)];
+        if(!(m >> p & 1)) T[m] = value;
+        else if(!loop_[v] && !(m & conflict) && value != NEG) T[m] = value + weight[v];
+      }
+    } else if(type == Forget) {
+      auto D = std::begin(bags_) + start_[left];
+      int p = std::lower_bound(D, D + s + 1, v) - D;
+      const auto& C = table[left];
+      taken[k].assign(T.size(), false);
+      for(std::uint32_t m = 0; m < T.size(); ++m) {
+        auto a = C[insert_bit(m, p, 0)], b = C[insert_bit(m, p, 1)];
+        T[m] = std::max(a, b);
+        taken[k][m] = a < b;
+      }
+    } else {
+      sum.assign(T.size(), 0);
+      for(std::uint32_t m = 1; m < T.size(); ++m) sum[m] = sum[m & (m - 1)] + weight[B[std::countr_zero(m)]];
+      const auto &L = table[left], &R = table[right];
+      for(std::uint32_t m = 0; m < T.size(); ++m) if(L[m] != NEG && R[m] != NEG) T[m] = L[m] + R[m] - sum[m];
+    }
+    if(type != Leaf) std::vector<Weight>().swap(table[left]);
+    if(type == Join) std::vector<Weight>().swap(table[right]);
+  }
+
+  // 根から bitmask をたどって復元する
+  std::vector<std::uint32_t> mask(K);
+  std::vector<bool> in(n_);
+  for(int k = K - 1; 0 <= k; --k) {
+    const auto& [type, v, left, right] = nice_[k];
+    auto m = mask[k];
+    if(type == Introduce) {
+      auto B = std::begin(bags_) + start_[k];
+      int p = std::lower_bound(B, std::begin(bags_) + start_[k + 1], v) - B;
+      if(m >> p & 1) in[v] = true;
+      mask[left] = erase_bit(m, p);
+    } else if(type == Forget) {
+      auto D = std::begin(bags_) + start_[left];
+      int p = std::lower_bound(D, std::begin(bags_) + start_[left + 1], v) - D;
+      mask[left] = insert_bit(m, p, taken[k][m]);
+    } else if(type == Join) {
+      mask[left] = mask[right] = m;
+    }
+  }
+  std::vector<Vertex> result;
+  for(Vertex v = 0; v < n_; ++v) if(in[v]) result.emplace_back(v);
+  return result;
+}
+
+std::vector<Vertex> TreeDecomposition::minimum_weight_vertex_cover(const std::vector<Weight>& weight) const {
+  auto S = maximum_weight_independent_set(weight);
+  std::vector<bool> in(n_);
+  for(auto v: S) in[v] = true;
+  std::vector<Vertex> result;
+  for(Vertex v = 0; v < n_; ++v) if(!in[v]) result.emplace_back(v);
+  return result;
+}
+
+#include<bits/stdc++.h>
+using namespace std;
+
+int main() {
+  /*
+  // ベンチマーク (1 コア, 各頂点を直前の k 頂点と確率 1/2 で結ぶ: 幅は k 以下)
+  //   n = 100000, k = 5:  MinDegree 幅 7 で 743ms,  MinFill 幅 7 で 1356ms
+  //   n = 10000,  k = 10: MinDegree 幅 19 で 6150ms, MinFill 幅 13 で 452ms
+  //   n = 10000,  k = 14: MinDegree 幅 30 (DP できない), MinFill 幅 17 で 1960ms
+  auto bench = [](int n, int k, TreeDecomposition::Heuristic heuristic) {
+    mt19937 rng(1);
+    Graph G(n);
+    for(Vertex v = 0; v < n; ++v) for(Vertex u = max(0, v - k); u < v; ++u) if(rng() % 2) {
+      G[u].push_back({u, v, 1});
+      G[v].push_back({v, u, 1});
+    }
+    auto start = chrono::steady_clock::now();
+    TreeDecomposition td(G, heuristic, TreeDecomposition::MAX_BAG - 1);
+    if(TreeDecomposition::MAX_BAG <= td.width()) {
+      cout << n << " " << k << ": width > " << TreeDecomposition::MAX_BAG - 1 << endl;
+      return;
+    }
+    auto S = td.maximum_independent_set();
+    auto end = chrono::steady_clock::now();
+    cout << n << " " << k << ": width " << td.width() << ", " << S.size() << " " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << "ms" << endl;
+  };
+  for(auto heuristic: {TreeDecomposition::Heuristic::MinDegree, TreeDecomposition::Heuristic::MinFill}) {
+    bench(100000, 5, heuristic);
+    bench(10000, 10, heuristic);
+    bench(10000, 14, heuristic);
+  }
+  */
+
+  // 4 頂点の閉路 0-1-2-3 と, 頂点 2 から伸びる道 2-4-5 (頂点 1 の重みだけ 5)
+  Graph G(6);
+  auto insert = [&](Vertex u, Vertex v) {
+    G[u].push_back({u, v, 1});
+    G[v].push_back({v, u, 1});
+  };
+  for(Vertex v = 0; v < 4; ++v) insert(v, (v + 1) % 4);
+  insert(2, 4); insert(4, 5);
+  TreeDecomposition td(G);
+  cout << "width " << td.width() << endl;
+  vector<Weight> weight = {1, 5, 1, 1, 1, 1};
+  for(auto S: {td.maximum_independent_set(), td.minimum_vertex_cover(), td.maximum_weight_independent_set(weight), td.minimum_weight_vertex_cover(weight)}) {
+    cout << S.size() << ":";
+    for(auto v: S) cout << " " << v;
+    cout << endl;
+  }
+}
@@ -259,6 +259,7 @@ template<MonoidLP M> class SegmentTreeLP {
     recalc(b);
   }
   M::L::S query(M::Idx a, M::Idx b) {
+    if(a >= b) return M::L::e();
     thrust(a += N);
     thrust(b += N - 1);
     auto vl = M::L::e(), vr = M::L::e();
@@ -275,7 +276,7 @@ template<MonoidLP M> class SegmentTreeLP {
   inline M::Idx parent(M::Idx k) const {return (k >> 1);}
   inline M::Idx lchild(M::Idx k) const {return (k << 1);}
   inline M::Idx rchild(M::Idx k) const {return (k << 1) | 1;}
-  inline M::L::S reflect(M::Idx k) const {return M::f(dat[k], laz[k], leqb(k)>>1);}
+  inline M::L::S reflect(M::Idx k) const {return M::f(dat[k], laz[k], N / leqb(k));}
   inline void propagate(M::Idx k) {
     if(laz[k] == M::R::e()) return;
     laz[lchild(k)] = M::R::f(laz[lchild(k)], laz[k]);
@@ -8,7 +8,15 @@
 //   重心:   削除したときにmin{各連結成分の頂点数}が最大となるような頂点
 
 #include<algorithm>
+#include<array>
+#include<bit>
+#include<cassert>
+#include<concepts>
+#include<cstdint>
 #include<functional>
+#include<limits>
+#include<numeric>
+#include<utility>
 #include<vector>
 
 using Size = int;
@@ -150,49 +158,561 @@ void rerooting(const Graph& G, Vertex root = 0) {
 //   for(auto v=0; v<G.size(); ++v) cout << std::accumulate(std::begin(dp[v]), std::end(dp[v]), DP(), [](auto s, auto p) {return s + p.second;}).addRoot().val << std::endl;
 }
 
-// Centroid Decomposition (っぽいもの)
-//   参考: https://blog.anudeep2011.com/heavy-light-decomposition/
-//   構築: O(|V| + |E|)
-//   LCA:  O(log |V|)
-// dfs するときに in/out の順番を覚えておくと部分木クエリにも対応できる (https://codeforces.com/blog/entry/53170)
+// 重心分解
+//   連結成分の重心を取り除くことを繰り返してできる, 重心を頂点とする深さ log |V| 以下の木 (重心木)
+//   u, v の重心木での LCA を c とすると, u - v パスは c を通る
+//   距離は辺の本数とする (重みは使わない)
+//   構築 O(|V| log |V|) (再帰しない)
+//     1 回目: 連結成分ごとに BFS をして部分木の大きさから重心を求め, 重心木の親 parent(v) と深さ level(v) を決める
+//     2 回目: 深さの浅い重心から順に, 成分内を BFS をして, 祖先の重心との距離を頂点ごとに並べて持つ
+//   重心 c ごとに, 成分内の印の付いた頂点の数を c からの距離ごとに数えた BIT (near) と,
+//   重心木の親からの距離ごとに数えた BIT (far) を 1 本の配列に並べて持つ (大きさは成分の半径程度)
+//   mark(v), unmark(v)   印を付ける, 外す O(log^2 |V|)
+//   nearest(v)           印の付いた頂点までの最短距離 (なければ -1) O(log^2 |V|)
+//                          祖先の重心 c ごとに, dist(v, c) + (c から最も近い印の距離 (BIT の二分探索)) の最小値
+//   count(v, k)          距離 k 以下にある印の付いた頂点の数 O(log^2 |V|)
+//                          祖先の重心 c ごとに near の和を足し, c の子の重心の成分の分 (far の和) を引く
+//   distance(u, v)       距離 O(log |V|)
 class CentroidDecomposition {
  public:
-  CentroidDecomposition(const Graph& G, Vertex root) : head(G.size()), parent(G.size(), NIL), depth(G.size(), 0), subsize(G.size(), 1) {
-    std::function<Size(Vertex)> dfs = [&](Vertex cur) {
-      for(const auto& e: G[cur]) if(e.to != parent[cur]) {
-        depth[e.to] = depth[cur] + 1;
-        parent[e.to] = cur;
-        subsize[cur] += dfs(e.to);
-      }
-      return subsize[cur];
-    };
-    std::function<void(Vertex)> build = [&](Vertex cur) {
-      Vertex nex = NIL;
-      Size size = 0;
-      for(const auto& e: G[cur]) if(e.to != parent[cur]) if(chmax(size, subsize[e.to]) == subsize[e.to]) nex = e.to;
-      for(const auto& e: G[cur]) if(e.to != parent[cur]) {
-        if(e.to == nex) head[e.to] = head[cur];
-        else            head[e.to] = e.to;
-        build(e.to);
+  CentroidDecomposition(const Graph& G, bool marked = false);
+  Vertex parent(Vertex v) const {return parent_[v];}
+  Size level(Vertex v) const {return level_[v];}
+  bool marked(Vertex v) const {return marked_[v];}
+  void mark(Vertex v) {
+    assert(!marked_[v]);
+    marked_[v] = true;
+    add(v, 1);
+  }
+  void unmark(Vertex v) {
+    assert(marked_[v]);
+    marked_[v] = false;
+    add(v, -1);
+  }
+  Size nearest(Vertex v) const;
+  Size count(Vertex v, Size k) const;
+  Size distance(Vertex u, Vertex v) const;
+ private:
+  std::vector<Size> level_;
+  std::vector<Vertex> parent_;
+  std::vector<bool> marked_;
+  std::vector<int> start_;       // 頂点 v と深さ l の祖先の重心との距離は dist_[start_[v] + l]
+  std::vector<Size> dist_;
+  std::vector<int> near_, far_;  // 重心 c の BIT は bit_[near_[c]], ..., bit_[near_[c + 1] - 1] (far_ も同じ)
+  std::vector<Size> bit_;
+  void add(Vertex v, int x);
+  Size sum(int first, int last, Size k) const {
+    Size result = 0;
+    for(int i = std::min(k + 1, last - first); 0 < i; i -= i & -i) result += bit_[first + i - 1];
+    return result;
+  }
+};
+
+CentroidDecomposition::CentroidDecomposition(const Graph& G, bool marked) : level_(G.size(), -1), parent_(G.size(), -1), marked_(G.size(), marked) {
+  const int n = G.size();
+  // 見つけた順に重心を並べる (重心木の親は子より前)
+  std::vector<Vertex> centroids, queue, up(n);
+  std::vector<Size> size(n);
+  std::vector<std::pair<Vertex, Vertex>> stack;   // (成分の頂点, 重心木の親)
+  centroids.reserve(n);
+  if(n) stack.emplace_back(0, -1);
+  while(!stack.empty()) {
+    auto [r, p] = stack.back();
+    stack.pop_back();
+    queue = {r};
+    up[r] = -1;
+    for(std::size_t i = 0; i < queue.size(); ++i) {
+      auto v = queue[i];
+      size[v] = 1;
+      for(const auto& e: G[v]) if(e.to != up[v] && level_[e.to] == -1) up[e.to] = v, queue.emplace_back(e.to);
+    }
+    for(auto i = queue.size() - 1; 0 < i; --i) size[up[queue[i]]] += size[queue[i]];
+    // 大きさが半分より大きい子がある限り降りる
+    const Size total = queue.size();
+    auto c = r;
+    for(bool moved = true; moved; ) {
+      moved = false;
+      for(const auto& e: G[c]) if(e.to != up[c] && level_[e.to] == -1 && total < 2 * size[e.to]) {c = e.to, moved = true; break;}
+    }
+    parent_[c] = p;
+    level_[c] = p == -1 ? 0 : level_[p] + 1;
+    centroids.emplace_back(c);
+    for(const auto& e: G[c]) if(level_[e.to] == -1) stack.emplace_back(e.to, c);
+  }
+  // 祖先の重心との距離 (親の重心の BFS が先に終わっているので, far の距離も引ける)
+  start_.assign(n + 1, 0);
+  for(int v = 0; v < n; ++v) start_[v + 1] = start_[v] + level_[v] + 1;
+  dist_.resize(start_[n]);
+  near_.assign(n + 1, 0);
+  far_.assign(n + 1, 0);
+  std::vector<Size> d(n);
+  for(auto c: centroids) {
+    const int l = level_[c];
+    Size radius = 0, outer = -1;
+    queue = {c};
+    up[c] = -1;
+    d[c] = 0;
+    for(std::size_t i = 0; i < queue.size(); ++i) {
+      auto v = queue[i];
+      dist_[start_[v] + l] = d[v];
+      radius = std::max(radius, d[v]);
+      if(0 < l) outer = std::max(outer, dist_[start_[v] + l - 1]);
+      for(const auto& e: G[v]) if(e.to != up[v] && l < level_[e.to]) up[e.to] = v, d[e.to] = d[v] + 1, queue.emplace_back(e.to);
+    }
+    near_[c + 1] = radius + 1;
+    far_[c + 1] = outer + 1;
+  }
+  for(int c = 0; c < n; ++c) near_[c + 1] += near_[c];
+  far_[0] = near_[n];
+  for(int c = 0; c < n; ++c) far_[c + 1] += far_[c];
+  bit_.assign(far_[n], 0);
+  if(!marked) return;
+  // 距離ごとに数えてから, 各 BIT を O(長さ) で作る
+  for(int v = 0; v < n; ++v) {
+    for(auto a = v; a != -1; a = parent_[a]) {
+      ++bit_[near_[a] + dist_[start_[v] + level_[a]]];
+      if(parent_[a] != -1) ++bit_[far_[a] + dist_[start_[v] + level_[a] - 1]];
+    }
+  }
+  for(const auto& offset: {near_, far_}) {
+    for(int c = 0; c < n; ++c) {
+      const int m = offset[c + 1] - offset[c];
+      for(int i = 1; i <= m; ++i) if(i + (i & -i) <= m) bit_[offset[c] + i + (i & -i) - 1] += bit_[offset[c] + i - 1];
+    }
+  }
+}
+
+void CentroidDecomposition::add(Vertex v, int x) {
+  for(auto a = v; a != -1; a = parent_[a]) {
+    const int m = near_[a + 1] - near_[a];
+    for(int i = dist_[start_[v] + level_[a]] + 1; i <= m; i += i & -i) bit_[near_[a] + i - 1] += x;
+    if(parent_[a] == -1) continue;
+    const int f = far_[a + 1] - far_[a];
+    for(int i = dist_[start_[v] + level_[a] - 1] + 1; i <= f; i += i & -i) bit_[far_[a] + i - 1] += x;
+  }
+}
+
+Size CentroidDecomposition::nearest(Vertex v) const {
+  Size best = -1;
+  for(auto a = v; a != -1; a = parent_[a]) {
+    auto d = dist_[start_[v] + level_[a]];
+    if(best != -1 && best <= d) continue;
+    // 和が 1 以上になる最初の位置 (BIT の二分探索)
+    const int m = near_[a + 1] - near_[a];
+    int i = 0;
+    for(int step = std::bit_floor(unsigned(m)); step; step >>= 1) if(i + step <= m && bit_[near_[a] + i + step - 1] == 0) i += step;
+    if(i < m && (best == -1 || d + i < best)) best = d + i;
+  }
+  return best;
+}
+
+Size CentroidDecomposition::count(Vertex v, Size k) const {
+  Size result = 0;
+  for(Vertex a = v, b = -1; a != -1; b = a, a = parent_[a]) {
+    auto d = dist_[start_[v] + level_[a]];
+    if(k < d) continue;
+    result += sum(near_[a], near_[a + 1], k - d);
+    if(b != -1) result -= sum(far_[b], far_[b + 1], k - d);
+  }
+  return result;
+}
+
+Size CentroidDecomposition::distance(Vertex u, Vertex v) const {
+  auto a = u, b = v;
+  while(level_[b] < level_[a]) a = parent_[a];
+  while(level_[a] < level_[b]) b = parent_[b];
+  while(a != b) a = parent_[a], b = parent_[b];
+  return dist_[start_[u] + level_[a]] + dist_[start_[v] + level_[a]];
+}
+
+// LCA (オイラーツアー + RMQ)
+//   SparseTable:  構築 O(|V| log |V|), クエリ O(1)
+//     行きがけ順 in[u] < in[v] のとき, 行きがけ順で (in[u], in[v]] にある頂点の親の行きがけ順の最小値が LCA
+//     (区間内の頂点はすべて LCA の部分木にあり, LCA の v 側の子が区間に含まれる)
+//     オイラーツアーの半分の長さの列の最小値になり, 深さを比べずに int の最小値だけを引ける
+//   PlusMinusOne: 構築 O(|V|), クエリ O(1), メモリは SparseTable の 1/5 程度
+//     オイラーツアーの深さは隣どうしで ±1 しか変わらないので, 64 個ずつのブロックに分けて増減を 1 ビットで持つ
+//     ブロック内の最小値は 8 ビットずつ表 (和, 最小の接頭辞和, その位置) を引いてたどる
+//     ブロックをまたぐ部分はブロックの最小値 (深さ << 32 | 位置) の sparse table で求める
+//     ブロックの先頭の深さを持っておき, 頂点の深さやオイラーツアーは最後の 1 回しか引かない
+//   再帰しない (深さ 10^6 のパスでもよい)
+class LowestCommonAncestor {
+ public:
+  enum class Method {SparseTable, PlusMinusOne};
+  LowestCommonAncestor(const Graph& G, Vertex root, Method method = Method::SparseTable);
+  Vertex operator()(Vertex u, Vertex v) const;
+  Size depth(Vertex v) const {return depth_[v];}
+ private:
+  struct Chunk {std::int8_t sum, low, at;};   // 増減 8 個の和, 最小の接頭辞和 (長さ 1 以上), その長さ - 1
+  static constexpr int B = 64;
+  Method method_;
+  std::vector<Size> depth_, in_;
+  std::vector<Vertex> order_;
+  std::vector<int> table_;                    // SparseTable: table_[k * n + i] = min(in[parent[order[i]]], ..., 2^k 個)
+  std::vector<Vertex> euler_;
+  std::vector<std::uint64_t> step_;           // ビット i: オイラーツアーで i - 1 番目から i 番目へ深くなるか
+  std::vector<Size> head_;                    // ブロックの先頭の深さ
+  std::vector<std::uint64_t> block_;          // block_[k * blocks + b]: ブロック b, ..., 2^k 個の最小値
+  std::vector<std::array<Chunk, 256>> chunk_; // chunk_[len - 1][bits]
+  std::uint64_t scan(int l, int r) const;
+};
+
+LowestCommonAncestor::LowestCommonAncestor(const Graph& G, Vertex root, Method method) : method_(method), depth_(G.size()), in_(G.size(), -1) {
+  const int n = G.size();
+  std::vector<Vertex> parent(n, root);
+  std::vector<std::pair<Vertex, Size>> stack{{root, 0}};
+  in_[root] = 0;
+  order_.emplace_back(root);
+  if(method_ == Method::PlusMinusOne) euler_.reserve(2 * n - 1), euler_.emplace_back(root);
+  while(!stack.empty()) {
+    auto& [v, i] = stack.back();
+    if(i == (Size)G[v].size()) {
+      stack.pop_back();
+      if(!stack.empty() && method_ == Method::PlusMinusOne) euler_.emplace_back(stack.back().first);
+      continue;
+    }
+    auto w = G[v][i++].to;
+    if(in_[w] != -1) continue;
+    in_[w] = order_.size();
+    order_.emplace_back(w);
+    parent[w] = v;
+    depth_[w] = depth_[v] + 1;
+    if(method_ == Method::PlusMinusOne) euler_.emplace_back(w);
+    stack.emplace_back(w, 0);
+  }
+  assert((int)order_.size() == n);
+  if(method_ == Method::SparseTable) {
+    const int K = std::bit_width(unsigned(n));
+    table_.resize(K * n);
+    for(int i = 0; i < n; ++i) table_[i] = in_[parent[order_[i]]];
+    for(int k = 1; k < K; ++k) {
+      for(int i = 0; i + (1 << k) <= n; ++i) table_[k * n + i] = std::min(table_[(k - 1) * n + i], table_[(k - 1) * n + i + (1 << (k - 1))]);
+    }
+    return;
+  }
+  // 行きがけ順はオイラーツアーの最初の出現位置に置き換える
+  const int m = euler_.size(), blocks = (m + B - 1) / B, K = std::bit_width(unsigned(blocks));
+  for(int i = m - 1; 0 <= i; --i) in_[euler_[i]] = i;
+  order_.clear();
+  order_.shrink_to_fit();
+  step_.assign(blocks, 0);
+  head_.resize(blocks);
+  block_.resize(K * blocks);
+  for(int b = 0; b < blocks; ++b) {
+    std::uint64_t low = UINT64_MAX;
+    head_[b] = depth_[euler_[b * B]];
+    for(int i = b * B; i < std::min(m, (b + 1) * B); ++i) {
+      if(0 < i && depth_[euler_[i - 1]] < depth_[euler_[i]]) step_[b] |= std::uint64_t(1) << (i % B);
+      low = std::min(low, std::uint64_t(depth_[euler_[i]]) << 32 | i);
+    }
+    block_[b] = low;
+  }
+  for(int k = 1; k < K; ++k) {
+    for(int b = 0; b + (1 << k) <= blocks; ++b) block_[k * blocks + b] = std::min(block_[(k - 1) * blocks + b], block_[(k - 1) * blocks + b + (1 << (k - 1))]);
+  }
+  chunk_.resize(8);
+  for(int len = 1; len <= 8; ++len) {
+    for(int bits = 0; bits < 256; ++bits) {
+      int sum = 0, low = 9, at = 0;
+      for(int j = 0; j < len; ++j) {
+        sum += bits >> j & 1 ? 1 : -1;
+        if(sum < low) low = sum, at = j;
       }
-    };
-    dfs(root);
-    build(head[root] = root);
+      chunk_[len - 1][bits] = {std::int8_t(sum), std::int8_t(low), std::int8_t(at)};
+    }
+  }
+}
+
+// 同じブロックにある区間 [l, r] の深さの最小値 (深さ << 32 | 位置)
+std::uint64_t LowestCommonAncestor::scan(int l, int r) const {
+  auto bits = step_[l / B];
+  int c = l % B, cur = std::popcount(bits & ((std::uint64_t(2) << c) - 2)) * 2 - c, best = cur, at = l;
+  for(int i = l + 1; i <= r; i += 8) {
+    int len = std::min(8, r - i + 1);
+    const auto& c = chunk_[len - 1][bits >> (i % B) & 255];
+    if(cur + c.low < best) best = cur + c.low, at = i + c.at;
+    cur += c.sum;
+  }
+  return std::uint64_t(head_[l / B] + best) << 32 | at;
+}
+
+Vertex LowestCommonAncestor::operator()(Vertex u, Vertex v) const {
+  if(u == v) return u;
+  auto l = in_[u], r = in_[v];
+  if(r < l) std::swap(l, r);
+  if(method_ == Method::SparseTable) {
+    ++l;
+    const int n = depth_.size(), k = std::bit_width(unsigned(r - l + 1)) - 1;
+    return order_[std::min(table_[k * n + l], table_[k * n + r - (1 << k) + 1])];
+  }
+  const int bl = l / B, br = r / B;
+  if(bl == br) return euler_[scan(l, r) & UINT32_MAX];
+  auto result = std::min(scan(l, bl * B + B - 1), scan(br * B, r));
+  if(bl + 1 < br) {
+    const int blocks = step_.size(), k = std::bit_width(unsigned(br - bl - 1)) - 1;
+    result = std::min({result, block_[k * blocks + bl + 1], block_[k * blocks + br - (1 << k)]});
+  }
+  return euler_[result & UINT32_MAX];
+}
+
+// LCA をまとめて求める (Tarjan のオフライン LCA) O((|V| + |Q|) α(|V|))
+//   帰りがけに子の集合を親の集合へ併合し, 併合した集合の代表に親を覚えさせる
+//   v の帰りがけに, 帰りがけ済みの w とのクエリの答えは w の集合が覚えている頂点
+std::vector<Vertex> lca(const Graph& G, Vertex root, const std::vector<std::pair<Vertex, Vertex>>& queries) {
+  const int n = G.size(), q = queries.size();
+  // 頂点ごとのクエリ (CSR)
+  std::vector<int> start(n + 1), query(2 * q);
+  for(const auto& [u, v]: queries) ++start[u + 1], ++start[v + 1];
+  for(int v = 0; v < n; ++v) start[v + 1] += start[v];
+  {
+    auto pos = start;
+    for(int i = 0; i < q; ++i) query[pos[queries[i].first]++] = i, query[pos[queries[i].second]++] = i;
+  }
+  std::vector<int> uf(n, -1);
+  std::vector<Vertex> ancestor(n);
+  std::iota(std::begin(ancestor), std::end(ancestor), 0);
+  auto find = [&](int v) {
+    while(0 <= uf[v] && 0 <= uf[uf[v]]) v = uf[v] = uf[uf[v]];
+    return 0 <= uf[v] ? uf[v] : v;
+  };
+  std::vector<Vertex> result(q);
+  std::vector<char> state(n);   // 0: 未訪問, 1: 訪問中, 2: 帰りがけ済み
+  std::vector<std::pair<Vertex, Size>> stack{{root, 0}};
+  state[root] = 1;
+  while(!stack.empty()) {
+    auto& [v, i] = stack.back();
+    if(i < (Size)G[v].size()) {
+      auto w = G[v][i++].to;
+      if(state[w] == 0) state[w] = 1, stack.emplace_back(w, 0);
+      continue;
+    }
+    state[v] = 2;
+    for(int j = start[v]; j < start[v + 1]; ++j) {
+      const auto& [a, b] = queries[query[j]];
+      auto w = a == v ? b : a;
+      if(state[w] == 2) result[query[j]] = ancestor[find(w)];
+    }
+    stack.pop_back();
+    if(stack.empty()) break;
+    // v の集合を親の集合へ併合する
+    auto p = stack.back().first, x = find(p), y = find(v);
+    if(uf[y] < uf[x]) std::swap(x, y);
+    uf[x] += uf[y];
+    uf[y] = x;
+    ancestor[x] = p;
+  }
+  return result;
+}
+
+// モノイド, セグメント木, 遅延伝播セグメント木 (SegmentTree.cpp と同じ)
+template<class T> concept Monoid = requires(T x, T::S s) {
+  {x.f(s, s)} -> std::same_as<typename T::S>;
+  {x.e()}     -> std::same_as<typename T::S>;
+};
+template<class T> concept MonoidLP = requires(T x, T::L::S l, T::R::S r, T::Idx n) {
+  requires Monoid<typename T::L>;
+  requires Monoid<typename T::R>;
+  {x.f(l, r, n)} -> std::same_as<typename T::L::S>;
+};
+struct SumLP {
+  struct M {
+    using S = long long;
+    static inline S e() {return S();};
+    static inline S f(S l, S r) {return l + r;}
+  };
+  using Idx = long long;
+  using L = M;
+  using R = M;
+  static inline L::S f(L::S l, R::S r, Idx n) {
+    if(r == R::e()) return l;
+    if(l == L::e()) return r * n;
+    return l + r * n;
+  }
+};
+// 非可換なモノイド M の区間の積を両向きに持つ (first は左から右, second は右から左への積)
+template<Monoid M> struct Bidirectional {
+  using S = std::pair<typename M::S, typename M::S>;
+  static inline S e() {return {M::e(), M::e()};};
+  static inline S f(const S& l, const S& r) {return {M::f(l.first, r.first), M::f(r.second, l.second)};}
+};
+template<Monoid M> class SegmentTree {
+ public:
+  using Idx = int;
+  SegmentTree(Idx n) : n(geqb(n)), dat(geqb(n) << 1, M::e()) {}
+  void update(Idx k, M::S x) {
+    dat[k += n] = x;
+    while((k = parent(k))) dat[k] = M::f(dat[lchild(k)], dat[rchild(k)]);
+  }
+  M::S query(Idx a, Idx b) const {
+    auto vl = M::e(), vr = M::e();
+    for(auto l = a + n, r = b + n; l < r; l = parent(l), r = parent(r)) {
+      if(l&1) vl = M::f(vl, dat[l++]);
+      if(r&1) vr = M::f(dat[--r], vr);
+    }
+    return M::f(vl, vr);
   }
+ private:
+  constexpr Idx geqb(Idx n) const {return n & (n - 1) ? geqb(n + (n & -n)) : n;}
+  inline Idx parent(Idx k) const {return (k >> 1);}
+  inline Idx lchild(Idx k) const {return (k << 1);}
+  inline Idx rchild(Idx k) const {return (k << 1) | 1;}
+  Idx n;
+  std::vector<typename M::S> dat;
+};
+template<MonoidLP M> class SegmentTreeLP {
+ public:
+  SegmentTreeLP(M::Idx n) : N(geqb(n)), H(lsb(geqb(n))), dat(geqb(n) << 1, M::L::e()), laz(geqb(n) << 1, M::R::e()) {}
+  void set(M::Idx a, M::L::S x) {
+    thrust(a += N);
+    dat[a] = x;
+    laz[a] = M::R::e();
+    recalc(a);
+  }
+  void update(M::Idx a, M::Idx b, M::R::S x) {
+    if(a >= b) return;
+    thrust(a += N);
+    thrust(b += N - 1);
+    for(auto l = a, r = b + 1; l < r; l = parent(l), r = parent(r)) {
+      if(l&1) laz[l] = M::R::f(laz[l], x), ++l;
+      if(r&1) --r, laz[r] = M::R::f(laz[r], x);
+    }
+    recalc(a);
+    recalc(b);
+  }
+  M::L::S query(M::Idx a, M::Idx b) {
+    if(a >= b) return M::L::e();
+    thrust(a += N);
+    thrust(b += N - 1);
+    auto vl = M::L::e(), vr = M::L::e();
+    for(auto l = a, r = b + 1; l < r; l = parent(l), r = parent(r)) {
+      if(l&1) vl = M::L::f(vl, reflect(l++));
+      if(r&1) vr = M::L::f(reflect(--r), vr);
+    }
+    return M::L::f(vl, vr);
+  }
+ private:
+  constexpr M::Idx geqb(M::Idx n) const {return n & (n - 1) ? geqb(n + (n & -n)) : n;}
+  constexpr M::Idx leqb(M::Idx n) const {return n & (n - 1) ? leqb(n & (n - 1)) : n;}
+  inline M::Idx lsb(M::Idx n) const {return n & 1 ? 0 : 1 + lsb(n >> 1);}
+  inline M::Idx parent(M::Idx k) const {return (k >> 1);}
+  inline M::Idx lchild(M::Idx k) const {return (k << 1);}
+  inline M::Idx rchild(M::Idx k) const {return (k << 1) | 1;}
+  inline M::L::S reflect(M::Idx k) const {return M::f(dat[k], laz[k], N / leqb(k));}
+  inline void propagate(M::Idx k) {
+    if(laz[k] == M::R::e()) return;
+    laz[lchild(k)] = M::R::f(laz[lchild(k)], laz[k]);
+    laz[rchild(k)] = M::R::f(laz[rchild(k)], laz[k]);
+    dat[k] = reflect(k);
+    laz[k] = M::R::e();
+  }
+  inline void thrust(M::Idx k) {for(auto i = H; i; --i) propagate(k >> i);}
+  inline void recalc(M::Idx k) {while(k >>= 1) dat[k] = M::L::f(reflect(lchild(k)), reflect(rchild(k)));}
+  M::Idx N, H;
+  std::vector<typename M::L::S> dat;
+  std::vector<typename M::R::S> laz;
+};
+
+// HL 分解 (heavy-light decomposition)
+//   参考: https://codeforces.com/blog/entry/53170
+//   重い子 (部分木が最も大きい子) を先にたどる行きがけ順で, 頂点 v の位置 in(v) を決める
+//     重い子だけをたどった列 (heavy path) は連続した区間になる
+//     v の部分木は区間 [in(v), out(v)) になる
+//     根から v へのパスの軽い辺は log |V| 本以下なので, u - v パスは O(log |V|) 個の区間に分かれる
+//   構築 O(|V|) (再帰しない), LCA O(log |V|)
+//   path(u, v, f, edge)  u から v へのパスを区間 [l, r) に分けて, u に近いものから順に f(l, r, reversed) を呼ぶ
+//                        reversed のときはパス上で r - 1 から l へ位置が減る向きにたどる (非可換なモノイドはこれで組み立てる)
+//                        edge のときは辺の値を子の位置に置いたものとして, LCA の位置を除く
+//   T を SegmentTree<M> または SegmentTreeLP<M> として, 頂点 v (edge のときは v と親を結ぶ辺) の値を位置 in(v) に置く
+//     query(T, u, v, edge)            パスの値の積 O(log^2 |V|)
+//                                     モノイドが非可換なら T を SegmentTree<Bidirectional<M>> とし, 値 x を (x, x) として置く
+//                                     (u から v への順の積を返す); それ以外の T ではモノイドは可換とする
+//     update(T, u, v, x, edge)        パスの更新 O(log^2 |V|)
+//     subtree_query(T, v, edge)       部分木の値の積 O(log |V|)
+//     subtree_update(T, v, x, edge)   部分木の更新 O(log |V|)
+class HeavyLightDecomposition {
+ public:
+  HeavyLightDecomposition(const Graph& G, Vertex root);
+  Size in(Vertex v) const {return in_[v];}
+  Size out(Vertex v) const {return out_[v];}
+  Vertex head(Vertex v) const {return head_[v];}
+  Vertex parent(Vertex v) const {return parent_[v];}
+  Size depth(Vertex v) const {return depth_[v];}
   Vertex lca(Vertex u, Vertex v) const {
-    while(head[u] != head[v]) {
-      if(depth[head[u]] > depth[head[v]]) std::swap(u, v);
-      v = parent[head[v]];
+    while(head_[u] != head_[v]) {
+      if(depth_[head_[u]] > depth_[head_[v]]) std::swap(u, v);
+      v = parent_[head_[v]];
     }
-    return depth[u] < depth[v] ? u : v;
+    return depth_[u] < depth_[v] ? u : v;
   }
+  template<class F> void path(Vertex u, Vertex v, F f, bool edge = false) const {
+    // v 側の区間は v に近いものから見つかるので, 逆順に呼ぶために覚えておく
+    std::array<std::pair<Size, Size>, 32> down;
+    int k = 0;
+    while(head_[u] != head_[v]) {
+      if(depth_[head_[v]] <= depth_[head_[u]]) f(in_[head_[u]], in_[u] + 1, true), u = parent_[head_[u]];
+      else down[k++] = {in_[head_[v]], in_[v] + 1}, v = parent_[head_[v]];
+    }
+    if(depth_[v] <= depth_[u]) f(in_[v] + edge, in_[u] + 1, true);
+    else                       f(in_[u] + edge, in_[v] + 1, false);
+    while(k) --k, f(down[k].first, down[k].second, false);
+  }
+  template<Monoid M> M::S query(const SegmentTree<M>& T, Vertex u, Vertex v, bool edge = false) const {
+    auto result = M::e();
+    path(u, v, [&](Size l, Size r, bool) {result = M::f(result, T.query(l, r));}, edge);
+    return result;
+  }
+  template<Monoid M> M::S query(const SegmentTree<Bidirectional<M>>& T, Vertex u, Vertex v, bool edge = false) const {
+    auto result = M::e();
+    path(u, v, [&](Size l, Size r, bool reversed) {
+      auto x = T.query(l, r);
+      result = M::f(result, reversed ? x.second : x.first);
+    }, edge);
+    return result;
+  }
+  template<MonoidLP M> M::L::S query(SegmentTreeLP<M>& T, Vertex u, Vertex v, bool edge = false) const {
+    auto result = M::L::e();
+    path(u, v, [&](Size l, Size r, bool) {result = M::L::f(result, T.query(l, r));}, edge);
+    return result;
+  }
+  template<MonoidLP M> void update(SegmentTreeLP<M>& T, Vertex u, Vertex v, M::R::S x, bool edge = false) const {
+    path(u, v, [&](Size l, Size r, bool) {T.update(l, r, x);}, edge);
+  }
+  template<Monoid M> M::S subtree_query(const SegmentTree<M>& T, Vertex v, bool edge = false) const {return T.query(in_[v] + edge, out_[v]);}
+  template<MonoidLP M> M::L::S subtree_query(SegmentTreeLP<M>& T, Vertex v, bool edge = false) const {return T.query(in_[v] + edge, out_[v]);}
+  template<MonoidLP M> void subtree_update(SegmentTreeLP<M>& T, Vertex v, M::R::S x, bool edge = false) const {T.update(in_[v] + edge, out_[v], x);}
  private:
-  inline Size position(Vertex v) {return depth[v] - depth[head[v]];}
-  template<typename T> inline T chmax(T& l, const T& r) {return l = std::max(l, r);};
-  const Size NIL = -1;
-  std::vector<Vertex> head, parent;
-  std::vector<Size> depth, subsize;
+  std::vector<Size> in_, out_, depth_;
+  std::vector<Vertex> head_, parent_;
 };
+
+HeavyLightDecomposition::HeavyLightDecomposition(const Graph& G, Vertex root) : in_(G.size()), out_(G.size(), 1), depth_(G.size()), head_(G.size()), parent_(G.size(), -1) {
+  const int n = G.size();
+  // 根から近い順に並べて, 逆順に部分木の大きさと重い子を求める
+  std::vector<Vertex> order{root}, heavy(n, -1);
+  order.reserve(n);
+  for(int i = 0; i < (int)order.size(); ++i) {
+    auto v = order[i];
+    for(const auto& e: G[v]) if(e.to != parent_[v]) parent_[e.to] = v, depth_[e.to] = depth_[v] + 1, order.emplace_back(e.to);
+  }
+  assert((int)order.size() == n);
+  for(int i = n - 1; 0 < i; --i) {
+    auto v = order[i], p = parent_[v];
+    out_[p] += out_[v];
+    if(heavy[p] == -1 || out_[heavy[p]] < out_[v]) heavy[p] = v;
+  }
+  // 重い子を最後に積んで, 最初に取り出す
+  std::vector<Vertex> stack{root};
+  head_[root] = root;
+  for(int t = 0; !stack.empty(); ++t) {
+    auto v = stack.back();
+    stack.pop_back();
+    in_[v] = t;
+    out_[v] += t;
+    for(const auto& e: G[v]) if(e.to != parent_[v] && e.to != heavy[v]) head_[e.to] = e.to, stack.emplace_back(e.to);
+    if(heavy[v] != -1) head_[heavy[v]] = head_[v], stack.emplace_back(heavy[v]);
+  }
+}
+
 /*
 class CentroidPathDecomposition {
  public:
@@ -253,4 +773,127 @@ class CentroidPathDecomposition {
 using namespace std;
 
 int main() {
+  /*
+  // ベンチマーク (1 コア, 頂点数 10^6 のランダムな木 (頂点 i の親は i 未満の乱数), ランダムな 10^6 クエリ)
+  //   SparseTable:  構築 432ms, クエリ 91ms
+  //   PlusMinusOne: 構築 431ms, クエリ 354ms (メモリは約 92MB → 約 20MB)
+  //   lca (Tarjan): 904ms
+  //   HeavyLightDecomposition::lca: 構築 342ms, クエリ 508ms
+  {
+    int n = 1000000, q = 1000000;
+    mt19937 rng(1);
+    Graph G(n);
+    for(int v = 1; v < n; ++v) {
+      int u = rng() % v;
+      G[u].push_back({u, v, 1});
+      G[v].push_back({v, u, 1});
+    }
+    vector<pair<Vertex, Vertex>> queries(q);
+    for(auto& [u, v]: queries) u = rng() % n, v = rng() % n;
+    for(auto method: {LowestCommonAncestor::Method::SparseTable, LowestCommonAncestor::Method::PlusMinusOne}) {
+      auto start = chrono::steady_clock::now();
+      LowestCommonAncestor L(G, 0, method);
+      auto middle = chrono::steady_clock::now();
+      long long sum = 0;
+      for(auto [u, v]: queries) sum += L(u, v);
+      auto end = chrono::steady_clock::now();
+      cout << sum << ": build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, query " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+    }
+    auto start = chrono::steady_clock::now();
+    auto result = lca(G, 0, queries);
+    auto finish = chrono::steady_clock::now();
+    cout << accumulate(begin(result), end(result), 0LL) << ": tarjan " << chrono::duration_cast<chrono::milliseconds>(finish - start).count() << "ms" << endl;
+    start = chrono::steady_clock::now();
+    HeavyLightDecomposition H(G, 0);
+    auto middle = chrono::steady_clock::now();
+    long long sum = 0;
+    for(auto [u, v]: queries) sum += H.lca(u, v);
+    finish = chrono::steady_clock::now();
+    cout << sum << ": build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, query " << chrono::duration_cast<chrono::milliseconds>(finish - middle).count() << "ms" << endl;
+  }
+  // CentroidDecomposition (頂点数 10^6 のランダムな木とパス, 印を付ける, 外す, nearest, count(v, 10) をランダムに 10^6 回)
+  //   ランダムな木: 構築 2530ms, クエリ 1090ms
+  //   パス:         構築 960ms, クエリ 2647ms (重心木の深さが 20 になる)
+  for(int path = 0; path < 2; ++path) {
+    int n = 1000000, q = 1000000;
+    mt19937 rng(1);
+    Graph G(n);
+    for(int v = 1; v < n; ++v) {
+      int u = path ? v - 1 : rng() % v;
+      G[u].push_back({u, v, 1});
+      G[v].push_back({v, u, 1});
+    }
+    auto start = chrono::steady_clock::now();
+    CentroidDecomposition C(G);
+    auto middle = chrono::steady_clock::now();
+    long long sum = 0;
+    for(int i = 0; i < q; ++i) {
+      int v = rng() % n;
+      switch(rng() % 3) {
+        case 0: C.marked(v) ? C.unmark(v) : C.mark(v); break;
+        case 1: sum += C.nearest(v); break;
+        case 2: sum += C.count(v, 10); break;
+      }
+    }
+    auto end = chrono::steady_clock::now();
+    cout << sum << ": build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, query " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  // HeavyLightDecomposition (頂点数 10^6 のランダムな木, SegmentTreeLP<SumLP> でパス加算とパス和を 5 * 10^5 回ずつ)
+  //   構築 412ms, 更新とクエリ 9290ms (1 回あたりの区間は平均 O(log n) 個で, それぞれ遅延伝播の O(log n))
+  {
+    int n = 1000000, q = 500000;
+    mt19937 rng(1);
+    Graph G(n);
+    for(int v = 1; v < n; ++v) {
+      int u = rng() % v;
+      G[u].push_back({u, v, 1});
+      G[v].push_back({v, u, 1});
+    }
+    auto start = chrono::steady_clock::now();
+    HeavyLightDecomposition H(G, 0);
+    auto middle = chrono::steady_clock::now();
+    SegmentTreeLP<SumLP> T(n);
+    long long sum = 0;
+    for(int i = 0; i < q; ++i) {
+      H.update(T, rng() % n, rng() % n, 1);
+      sum += H.query(T, rng() % n, rng() % n);
+    }
+    auto end = chrono::steady_clock::now();
+    cout << sum << ": build " << chrono::duration_cast<chrono::milliseconds>(middle - start).count() << "ms, query " << chrono::duration_cast<chrono::milliseconds>(end - middle).count() << "ms" << endl;
+  }
+  */
+
+  // 根 0, 辺 0-1, 0-2, 1-3, 1-4, 2-5
+  Graph G(6);
+  for(auto [u, v]: vector<pair<Vertex, Vertex>>{{0, 1}, {0, 2}, {1, 3}, {1, 4}, {2, 5}}) {
+    G[u].push_back({u, v, 1});
+    G[v].push_back({v, u, 1});
+  }
+  vector<pair<Vertex, Vertex>> queries{{3, 4}, {3, 5}, {4, 1}, {5, 5}};
+  LowestCommonAncestor A(G, 0), B(G, 0, LowestCommonAncestor::Method::PlusMinusOne);
+  auto C = lca(G, 0, queries);
+  for(int i = 0; i < (int)queries.size(); ++i) {
+    auto [u, v] = queries[i];
+    cout << "lca(" << u << ", " << v << ") = " << A(u, v) << " " << B(u, v) << " " << C[i] << endl;
+  }
+  // 頂点 v の値を v として, パス 3 - 5 に 10 を足してから, パス 4 - 5 と部分木 1 の和
+  HeavyLightDecomposition H(G, 0);
+  SegmentTreeLP<SumLP> T(6);
+  for(int v = 0; v < 6; ++v) T.set(H.in(v), v);
+  H.update(T, 3, 5, 10);
+  cout << "path(4, 5) = " << H.query(T, 4, 5) << ", subtree(1) = " << H.subtree_query(T, 1) << endl;
+  // 頂点 v の値を文字 'a' + v として, パスの文字列 (連結は非可換なので両向きの積を持つ)
+  struct Concat {
+    using S = string;
+    static S e() {return S();}
+    static S f(const S& l, const S& r) {return l + r;}
+  };
+  SegmentTree<Bidirectional<Concat>> U(6);
+  for(int v = 0; v < 6; ++v) U.update(H.in(v), {string(1, 'a' + v), string(1, 'a' + v)});
+  cout << "path(3, 5) = " << H.query(U, 3, 5) << ", path(5, 3) = " << H.query(U, 5, 3) << endl;
+  // 頂点 3, 5 に印を付けて, 頂点 4 から最も近い印までの距離と, 距離 3 以下の印の数
+  CentroidDecomposition D(G);
+  D.mark(3);
+  D.mark(5);
+  cout << "nearest(4) = " << D.nearest(4) << ", count(4, 3) = " << D.count(4, 3) << ", distance(4, 5) = " << D.distance(4, 5) << endl;
 }